@@ -0,0 +1,642 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <functional>
+#include <new>
+
+namespace dbclt
+{
+namespace detail
+{
+class flatbuffer_builder
+{
+public:
+	using writer_fn = std::function< size_t( flatbuffer_builder& ) >;
+
+	struct table_field
+	{
+		uint16_t id;
+		uint8_t size;
+		uint64_t value;
+		writer_fn child;
+	};
+
+public:
+	flatbuffer_builder( );
+
+	size_t add_table( const std::vector< table_field >& fields );
+	size_t add_table_vector( const std::vector< writer_fn >& tables );
+	size_t add_string( std::string_view value );
+
+	template< typename T >
+	size_t add_struct_vector( const std::vector< T >& values );
+
+	const std::vector< uint8_t >& finish( size_t root );
+
+private:
+	void align( size_t alignment, size_t shift = 0 );
+	void patch_offset( size_t pos, size_t target );
+
+	template< typename T >
+	void put( size_t pos, T value );
+
+private:
+	std::vector< uint8_t > m_buffer;
+};
+
+class aligned_buffer
+{
+public:
+	static constexpr size_t alignment = 64;
+
+public:
+	aligned_buffer( ) = default;
+	~aligned_buffer( );
+
+	const uint8_t* data( ) const;
+	uint8_t* data( );
+	size_t size( ) const;
+	void clear( );
+
+	template< typename T >
+	void push_back( T value );
+	void append( const void* data, size_t size );
+	void push_bit( bool value );
+
+private:
+	void grow( size_t size );
+
+private:
+	uint8_t* m_data { nullptr };
+	size_t m_size { 0 };
+	size_t m_capacity { 0 };
+	size_t m_bits { 0 };
+
+private:
+	aligned_buffer( const aligned_buffer& ) = delete;
+	aligned_buffer& operator=( const aligned_buffer& ) = delete;
+};
+
+struct arrow_column
+{
+	field::type type;
+	size_t nulls { 0 };
+	aligned_buffer validity;
+	aligned_buffer offsets;
+	aligned_buffer values;
+};
+
+// binary and utf8 columns, the formatted types are written as text
+inline bool has_offsets( field::type type )
+{
+	return type == field::type::db_string || type == field::type::db_binary ||
+		   is_formatted( type );
+}
+
+}  // namespace detail
+
+template< typename Sink >
+class arrow_writer
+{
+public:
+	static constexpr size_t default_batch_size = 64 * 1024;
+
+public:
+	arrow_writer( Sink sink, size_t batchSize = default_batch_size );
+
+	template< typename BE >
+	void write( recordset< BE >& rs );
+
+	void close( );
+
+private:
+	void write_schema( const fields_type& fields );
+	void write_batch( );
+	void write_message( const std::vector< uint8_t >& metadata );
+	void write_padding( size_t size );
+
+	template< typename R >
+	void append( const R& record );
+
+private:
+	Sink m_sink;
+	size_t m_batchSize;
+	size_t m_rows { 0 };
+	bool m_schemaWritten { false };
+	std::vector< std::unique_ptr< detail::arrow_column > > m_columns;
+
+private:
+	// arrow flatbuffer enums
+	enum
+	{
+		metadata_v5 = 4,
+		header_schema = 1,
+		header_record_batch = 3,
+		type_int = 2,
+		type_floating_point = 3,
+		type_binary = 4,
+		type_utf8 = 5,
+		type_bool = 6,
+		type_date = 8,
+		type_timestamp = 10,
+		precision_single = 1,
+		precision_double = 2,
+		date_unit_day = 0,
+		time_unit_microsecond = 2
+	};
+
+	struct buffer_desc
+	{
+		int64_t offset;
+		int64_t length;
+	};
+
+	struct node_desc
+	{
+		int64_t length;
+		int64_t nullCount;
+	};
+};
+
+namespace detail
+{
+inline flatbuffer_builder::flatbuffer_builder( )
+{
+	// room for the root offset
+	m_buffer.resize( sizeof( uint32_t ) );
+}
+
+template< typename T >
+inline void flatbuffer_builder::put( size_t pos, T value )
+{
+	if( m_buffer.size( ) < pos + sizeof( T ) )
+		m_buffer.resize( pos + sizeof( T ) );
+	memcpy( &m_buffer[ pos ], &value, sizeof( T ) );
+}
+
+inline void flatbuffer_builder::align( size_t alignment, size_t shift )
+{
+	while( ( m_buffer.size( ) + shift ) % alignment != 0 )
+		m_buffer.push_back( 0 );
+}
+
+inline void flatbuffer_builder::patch_offset( size_t pos, size_t target )
+{
+	// offsets are unsigned and relative to their own position, children always follow
+	put( pos, ( uint32_t )( target - pos ) );
+}
+
+inline size_t flatbuffer_builder::add_table( const std::vector< table_field >& fields )
+{
+	uint16_t slots = 0;
+	for( const table_field& fld: fields )
+		slots = std::max< uint16_t >( slots, fld.id + 1 );
+
+	// vtable immediately precedes its table
+	align( sizeof( uint16_t ) );
+	const size_t vtable = m_buffer.size( );
+	m_buffer.resize( vtable + ( 2 + slots ) * sizeof( uint16_t ), 0 );
+
+	align( sizeof( uint64_t ) );
+	const size_t table = m_buffer.size( );
+	put( table, ( int32_t )( table - vtable ) );
+
+	// lay out the widest fields first to keep them naturally aligned
+	std::vector< std::pair< const table_field*, size_t > > positions;
+	size_t size = sizeof( int32_t );
+	for( uint8_t width: { 8, 4, 2, 1 } )
+		for( const table_field& fld: fields )
+			if( fld.size == width )
+			{
+				size = ( size + width - 1 ) / width * width;
+				positions.emplace_back( &fld, table + size );
+				put( vtable + ( 2 + fld.id ) * sizeof( uint16_t ), ( uint16_t )size );
+				size += width;
+			}
+
+	size = ( size + 3 ) / 4 * 4;
+	m_buffer.resize( table + size, 0 );
+	put( vtable, ( uint16_t )( ( 2 + slots ) * sizeof( uint16_t ) ) );
+	put( vtable + sizeof( uint16_t ), ( uint16_t )size );
+
+	for( const std::pair< const table_field*, size_t >& pos: positions )
+	{
+		const table_field& fld = *pos.first;
+		if( fld.child )
+			patch_offset( pos.second, fld.child( *this ) );
+		else if( fld.size == 8 )
+			put( pos.second, fld.value );
+		else if( fld.size == 4 )
+			put( pos.second, ( uint32_t )fld.value );
+		else if( fld.size == 2 )
+			put( pos.second, ( uint16_t )fld.value );
+		else
+			put( pos.second, ( uint8_t )fld.value );
+	}
+
+	return table;
+}
+
+inline size_t flatbuffer_builder::add_table_vector( const std::vector< writer_fn >& tables )
+{
+	align( sizeof( uint32_t ) );
+	const size_t vec = m_buffer.size( );
+	put( vec, ( uint32_t )tables.size( ) );
+	m_buffer.resize( vec + ( 1 + tables.size( ) ) * sizeof( uint32_t ), 0 );
+
+	for( size_t i = 0; i < tables.size( ); ++i )
+		patch_offset( vec + ( 1 + i ) * sizeof( uint32_t ), tables[ i ]( *this ) );
+
+	return vec;
+}
+
+inline size_t flatbuffer_builder::add_string( std::string_view value )
+{
+	align( sizeof( uint32_t ) );
+	const size_t str = m_buffer.size( );
+	put( str, ( uint32_t )value.size( ) );
+	m_buffer.insert( m_buffer.end( ), value.begin( ), value.end( ) );
+	m_buffer.push_back( 0 );
+	return str;
+}
+
+template< typename T >
+inline size_t flatbuffer_builder::add_struct_vector( const std::vector< T >& values )
+{
+	// the length prefix sits right before 8 bytes aligned elements
+	align( sizeof( uint64_t ), sizeof( uint32_t ) );
+	const size_t vec = m_buffer.size( );
+	put( vec, ( uint32_t )values.size( ) );
+	for( const T& value: values )
+		put( m_buffer.size( ), value );
+	return vec;
+}
+
+inline const std::vector< uint8_t >& flatbuffer_builder::finish( size_t root )
+{
+	patch_offset( 0, root );
+	align( sizeof( uint64_t ) );
+	return m_buffer;
+}
+
+inline aligned_buffer::~aligned_buffer( )
+{
+	if( m_data )
+		::operator delete( m_data, std::align_val_t( alignment ) );
+}
+
+inline const uint8_t* aligned_buffer::data( ) const
+{
+	return m_data;
+}
+
+inline uint8_t* aligned_buffer::data( )
+{
+	return m_data;
+}
+
+inline size_t aligned_buffer::size( ) const
+{
+	return m_size;
+}
+
+inline void aligned_buffer::clear( )
+{
+	m_size = 0;
+	m_bits = 0;
+}
+
+inline void aligned_buffer::grow( size_t size )
+{
+	if( size <= m_capacity )
+		return;
+
+	const size_t capacity = std::max( size, std::max( m_capacity * 2, alignment ) );
+	uint8_t* data = ( uint8_t* )::operator new( capacity, std::align_val_t( alignment ) );
+	if( m_data )
+	{
+		memcpy( data, m_data, m_size );
+		::operator delete( m_data, std::align_val_t( alignment ) );
+	}
+	m_data = data;
+	m_capacity = capacity;
+}
+
+template< typename T >
+inline void aligned_buffer::push_back( T value )
+{
+	append( &value, sizeof( T ) );
+}
+
+inline void aligned_buffer::append( const void* data, size_t size )
+{
+	if( size == 0 )
+		return;
+	grow( m_size + size );
+	memcpy( m_data + m_size, data, size );
+	m_size += size;
+}
+
+inline void aligned_buffer::push_bit( bool value )
+{
+	if( m_bits % 8 == 0 )
+	{
+		grow( m_size + 1 );
+		m_data[ m_size++ ] = 0;
+	}
+	if( value )
+		m_data[ m_size - 1 ] |= ( uint8_t )( 1 << ( m_bits % 8 ) );
+	++m_bits;
+}
+
+}  // namespace detail
+
+template< typename Sink >
+inline arrow_writer< Sink >::arrow_writer( Sink sink, size_t batchSize )
+	: m_sink( sink ),
+	  m_batchSize( std::max< size_t >( batchSize, 1 ) )
+{
+}
+
+template< typename Sink >
+template< typename BE >
+inline void arrow_writer< Sink >::write( recordset< BE >& rs )
+{
+	if( !m_schemaWritten )
+		write_schema( rs.fields( ) );
+	else if( rs.fields( ).size( ) != m_columns.size( ) )
+		throw data_exception( "Recordset does not match the arrow stream schema" );
+
+	for( const typename BE::recordset_value_type& rec: rs )
+	{
+		append( rec );
+		if( ++m_rows == m_batchSize )
+			write_batch( );
+	}
+
+	if( m_rows > 0 )
+		write_batch( );
+}
+
+template< typename Sink >
+inline void arrow_writer< Sink >::close( )
+{
+	if( m_rows > 0 )
+		write_batch( );
+
+	const uint32_t eos[] = { 0xFFFFFFFF, 0 };
+	m_sink.write( ( const char* )eos, sizeof( eos ) );
+}
+
+template< typename Sink >
+template< typename R >
+inline void arrow_writer< Sink >::append( const R& record )
+{
+	for( size_t i = 0; i < m_columns.size( ); ++i )
+	{
+		detail::arrow_column& col = *m_columns[ i ];
+		const bool isNull = record.is_null( i );
+		col.validity.push_bit( !isNull );
+		col.nulls += isNull;
+
+		switch( col.type )
+		{
+		case field::type::db_bool: col.values.push_bit( !isNull && record.get_bool( i ) ); break;
+		case field::type::db_int8:
+			col.values.push_back( isNull ? 0 : record.get_int8( i ) );
+			break;
+		case field::type::db_int16:
+			col.values.push_back( isNull ? 0 : record.get_int16( i ) );
+			break;
+		case field::type::db_int32:
+			col.values.push_back( isNull ? 0 : record.get_int32( i ) );
+			break;
+		case field::type::db_int64:
+			col.values.push_back( isNull ? 0 : record.get_int64( i ) );
+			break;
+		case field::type::db_float:
+			col.values.push_back( isNull ? 0 : record.get_float( i ) );
+			break;
+		case field::type::db_double:
+			col.values.push_back( isNull ? 0 : record.get_double( i ) );
+			break;
+		case field::type::db_date:
+		{
+			const int64_t usecs = isNull ? 0 : record.get_date( i ).time_since_epoch( ).count( );
+			constexpr int64_t usecsPerDay = 86400LL * 1000000;
+			col.values.push_back(
+				( int32_t )( usecs >= 0 ? usecs / usecsPerDay : ( usecs + 1 ) / usecsPerDay - 1 ) );
+			break;
+		}
+		case field::type::db_datetime:
+			col.values.push_back(
+				( int64_t )( isNull ? 0 : record.get_datetime( i ).time_since_epoch( ).count( ) ) );
+			break;
+		default:
+			if( col.offsets.size( ) == 0 )
+				col.offsets.push_back( ( int32_t )0 );
+			if( !isNull && detail::is_formatted( col.type ) )
+			{
+				const std::string value = record.get_string( i );
+				col.values.append( value.data( ), value.size( ) );
+			}
+			else if( !isNull )
+			{
+				const std::string_view value = record.get_string_view( i );
+				col.values.append( value.data( ), value.size( ) );
+			}
+			if( col.values.size( ) > ( size_t )INT32_MAX )
+				throw data_exception( "Arrow batch exceeds 2GB of variable length data" );
+			col.offsets.push_back( ( int32_t )col.values.size( ) );
+		}
+	}
+}
+
+template< typename Sink >
+inline void arrow_writer< Sink >::write_schema( const fields_type& fields )
+{
+	using table_field = detail::flatbuffer_builder::table_field;
+	using writer_fn = detail::flatbuffer_builder::writer_fn;
+
+	m_columns.clear( );
+	std::vector< writer_fn > fieldWriters;
+	for( const field& fld: fields )
+	{
+		m_columns.emplace_back( new detail::arrow_column( ) );
+		m_columns.back( )->type = fld.db_type( );
+
+		uint8_t typeType;
+		std::vector< table_field > typeFields;
+		switch( fld.db_type( ) )
+		{
+		case field::type::db_bool: typeType = type_bool; break;
+		case field::type::db_int8:
+		case field::type::db_int16:
+		case field::type::db_int32:
+		case field::type::db_int64:
+		{
+			const uint32_t bits = fld.db_type( ) == field::type::db_int8	? 8
+								: fld.db_type( ) == field::type::db_int16 ? 16
+								: fld.db_type( ) == field::type::db_int32 ? 32
+																		  : 64;
+			typeType = type_int;
+			typeFields = { { 0, 4, bits, nullptr }, { 1, 1, 1, nullptr } };
+			break;
+		}
+		case field::type::db_float:
+			typeType = type_floating_point;
+			typeFields = { { 0, 2, precision_single, nullptr } };
+			break;
+		case field::type::db_double:
+			typeType = type_floating_point;
+			typeFields = { { 0, 2, precision_double, nullptr } };
+			break;
+		case field::type::db_binary: typeType = type_binary; break;
+		case field::type::db_date:
+			typeType = type_date;
+			typeFields = { { 0, 2, date_unit_day, nullptr } };
+			break;
+		case field::type::db_datetime:
+			typeType = type_timestamp;
+			typeFields = { { 0, 2, time_unit_microsecond, nullptr } };
+			break;
+		default: typeType = type_utf8;
+		}
+
+		const std::string name = fld.name( );
+		auto fieldWriter = [ name, typeType, typeFields ]( detail::flatbuffer_builder& fb ) {
+			auto nameWriter = [ & ]( detail::flatbuffer_builder& fb ) {
+				return fb.add_string( name );
+			};
+			auto typeWriter = [ & ]( detail::flatbuffer_builder& fb ) {
+				return fb.add_table( typeFields );
+			};
+			auto childrenWriter = []( detail::flatbuffer_builder& fb ) {
+				return fb.add_table_vector( { } );
+			};
+			return fb.add_table( { { 0, 4, 0, nameWriter },
+								   { 1, 1, 1, nullptr },
+								   { 2, 1, typeType, nullptr },
+								   { 3, 4, 0, typeWriter },
+								   { 5, 4, 0, childrenWriter } } );
+		};
+		fieldWriters.emplace_back( fieldWriter );
+	}
+
+	auto fieldsWriter = [ & ]( detail::flatbuffer_builder& fb ) {
+		return fb.add_table_vector( fieldWriters );
+	};
+	auto schemaWriter = [ & ]( detail::flatbuffer_builder& fb ) {
+		return fb.add_table( { { 0, 2, 0, nullptr }, { 1, 4, 0, fieldsWriter } } );
+	};
+
+	detail::flatbuffer_builder fb;
+	const size_t root = fb.add_table( { { 0, 2, metadata_v5, nullptr },
+										{ 1, 1, header_schema, nullptr },
+										{ 2, 4, 0, schemaWriter },
+										{ 3, 8, 0, nullptr } } );
+
+	write_message( fb.finish( root ) );
+	m_schemaWritten = true;
+}
+
+template< typename Sink >
+inline void arrow_writer< Sink >::write_batch( )
+{
+	constexpr size_t alignment = detail::aligned_buffer::alignment;
+
+	std::vector< node_desc > nodes;
+	std::vector< buffer_desc > buffers;
+	std::vector< const detail::aligned_buffer* > bodies;
+	int64_t bodyLength = 0;
+	auto add_buffer = [ & ]( const detail::aligned_buffer* buf ) {
+		const int64_t length = buf ? ( int64_t )buf->size( ) : 0;
+		buffers.push_back( { bodyLength, length } );
+		bodies.push_back( buf );
+		bodyLength += ( length + alignment - 1 ) / alignment * alignment;
+	};
+
+	for( const std::unique_ptr< detail::arrow_column >& col: m_columns )
+	{
+		nodes.push_back( { ( int64_t )m_rows, ( int64_t )col->nulls } );
+		add_buffer( col->nulls > 0 ? &col->validity : nullptr );
+		if( detail::has_offsets( col->type ) )
+			add_buffer( &col->offsets );
+		add_buffer( &col->values );
+	}
+
+	auto nodesWriter = [ & ]( detail::flatbuffer_builder& fb ) {
+		return fb.add_struct_vector( nodes );
+	};
+	auto buffersWriter = [ & ]( detail::flatbuffer_builder& fb ) {
+		return fb.add_struct_vector( buffers );
+	};
+	auto batchWriter = [ & ]( detail::flatbuffer_builder& fb ) {
+		return fb.add_table(
+			{ { 0, 8, m_rows, nullptr }, { 1, 4, 0, nodesWriter }, { 2, 4, 0, buffersWriter } } );
+	};
+
+	detail::flatbuffer_builder fb;
+	const size_t root = fb.add_table( { { 0, 2, metadata_v5, nullptr },
+										{ 1, 1, header_record_batch, nullptr },
+										{ 2, 4, 0, batchWriter },
+										{ 3, 8, ( uint64_t )bodyLength, nullptr } } );
+
+	write_message( fb.finish( root ) );
+	for( size_t i = 0; i < bodies.size( ); ++i )
+	{
+		if( bodies[ i ] == nullptr )
+			continue;
+		m_sink.write( ( const char* )bodies[ i ]->data( ), bodies[ i ]->size( ) );
+		write_padding( ( alignment - bodies[ i ]->size( ) % alignment ) % alignment );
+	}
+
+	for( std::unique_ptr< detail::arrow_column >& col: m_columns )
+	{
+		col->nulls = 0;
+		col->validity.clear( );
+		col->offsets.clear( );
+		col->values.clear( );
+	}
+	m_rows = 0;
+}
+
+template< typename Sink >
+inline void arrow_writer< Sink >::write_message( const std::vector< uint8_t >& metadata )
+{
+	const uint32_t prefix[] = { 0xFFFFFFFF, ( uint32_t )metadata.size( ) };
+	m_sink.write( ( const char* )prefix, sizeof( prefix ) );
+	m_sink.write( ( const char* )metadata.data( ), metadata.size( ) );
+}
+
+template< typename Sink >
+inline void arrow_writer< Sink >::write_padding( size_t size )
+{
+	static const char zeros[ detail::aligned_buffer::alignment ] = { };
+	m_sink.write( zeros, size );
+}
+
+}  // namespace dbclt
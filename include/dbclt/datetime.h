@@ -31,4 +31,7 @@ namespace dbclt
 // date range: -28164-12-21T19:59:05.224192 to 32103-01-10T04:00:54.775807
 using datetime = std::chrono::time_point< std::chrono::system_clock, std::chrono::microseconds >;
 
+// time of day since midnight, without a date
+using time_of_day = std::chrono::microseconds;
+
 }  // namespace dbclt
@@ -0,0 +1,385 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+namespace dbclt
+{
+// fixed point number: sign, 128 bit coefficient and decimal scale, about 38 significant digits
+// value = coefficient / 10^scale
+class decimal
+{
+public:
+	// unsigned 128 bit integer kept in two halves for compilers without __int128
+	struct uint128
+	{
+		// coefficient = coefficient * factor + addend, false on overflow
+		bool mul_add( uint32_t factor, uint32_t addend );
+		// coefficient = coefficient / divisor, returns the remainder
+		uint32_t div_mod( uint32_t divisor );
+
+		bool mul_pow10( size_t digits );
+		void div_pow10( size_t digits );
+
+		bool is_zero( ) const;
+		int compare( const uint128& other ) const;
+
+		uint64_t high { 0 };
+		uint64_t low { 0 };
+	};
+
+	static constexpr uint16_t max_scale = 38;
+
+	static constexpr uint32_t pow10[] = { 1, 10, 100, 1000, 10000,
+										  100000, 1000000, 10000000, 100000000, 1000000000 };
+
+public:
+	decimal( );
+	decimal( int64_t value );
+	decimal( int64_t unscaled, uint16_t scale );
+	decimal( const uint128& coefficient, uint16_t scale, bool negative );
+	explicit decimal( std::string_view text );
+
+	static decimal nan( );
+
+	bool is_nan( ) const;
+	bool is_negative( ) const;
+	bool is_zero( ) const;
+	uint16_t scale( ) const;
+	const uint128& coefficient( ) const;
+
+	// digits beyond a smaller scale are truncated
+	decimal rescale( uint16_t scale ) const;
+
+	double to_double( ) const;
+	std::string to_string( ) const;
+
+	// nan compares unequal to everything, itself included
+	bool operator==( const decimal& other ) const;
+	bool operator!=( const decimal& other ) const;
+	bool operator<( const decimal& other ) const;
+	bool operator>( const decimal& other ) const;
+	bool operator<=( const decimal& other ) const;
+	bool operator>=( const decimal& other ) const;
+
+private:
+	int compare( const decimal& other ) const;
+
+private:
+	uint128 m_coefficient;
+	uint16_t m_scale { 0 };
+	bool m_negative { false };
+	bool m_nan { false };
+};
+
+inline bool decimal::uint128::mul_add( uint32_t factor, uint32_t addend )
+{
+	uint32_t words[ 4 ] = { ( uint32_t )low, ( uint32_t )( low >> 32 ), ( uint32_t )high,
+							( uint32_t )( high >> 32 ) };
+	uint64_t carry = addend;
+	for( uint32_t& word: words )
+	{
+		const uint64_t product = ( uint64_t )word * factor + carry;
+		word = ( uint32_t )product;
+		carry = product >> 32;
+	}
+
+	low = ( ( uint64_t )words[ 1 ] << 32 ) | words[ 0 ];
+	high = ( ( uint64_t )words[ 3 ] << 32 ) | words[ 2 ];
+	return carry == 0;
+}
+
+inline uint32_t decimal::uint128::div_mod( uint32_t divisor )
+{
+	uint32_t words[ 4 ] = { ( uint32_t )( high >> 32 ), ( uint32_t )high,
+							( uint32_t )( low >> 32 ), ( uint32_t )low };
+	uint64_t remainder = 0;
+	for( uint32_t& word: words )
+	{
+		const uint64_t dividend = ( remainder << 32 ) | word;
+		word = ( uint32_t )( dividend / divisor );
+		remainder = dividend % divisor;
+	}
+
+	high = ( ( uint64_t )words[ 0 ] << 32 ) | words[ 1 ];
+	low = ( ( uint64_t )words[ 2 ] << 32 ) | words[ 3 ];
+	return ( uint32_t )remainder;
+}
+
+inline bool decimal::uint128::mul_pow10( size_t digits )
+{
+	for( ; digits > 9; digits -= 9 )
+		if( !mul_add( pow10[ 9 ], 0 ) )
+			return false;
+	return mul_add( pow10[ digits ], 0 );
+}
+
+inline void decimal::uint128::div_pow10( size_t digits )
+{
+	for( ; digits > 9; digits -= 9 )
+		div_mod( pow10[ 9 ] );
+	div_mod( pow10[ digits ] );
+}
+
+inline bool decimal::uint128::is_zero( ) const
+{
+	return high == 0 && low == 0;
+}
+
+inline int decimal::uint128::compare( const uint128& other ) const
+{
+	if( high != other.high )
+		return high < other.high ? -1 : 1;
+	if( low != other.low )
+		return low < other.low ? -1 : 1;
+	return 0;
+}
+
+inline decimal::decimal( )
+{
+}
+
+inline decimal::decimal( int64_t value ) : decimal( value, 0 )
+{
+}
+
+inline decimal::decimal( int64_t unscaled, uint16_t scale )
+	: m_scale( scale ),
+	  m_negative( unscaled < 0 )
+{
+	if( scale > max_scale )
+		throw data_exception( "Invalid decimal scale: " + std::to_string( scale ) );
+	m_coefficient.low = unscaled < 0 ? 0 - ( uint64_t )unscaled : ( uint64_t )unscaled;
+}
+
+inline decimal::decimal( const uint128& coefficient, uint16_t scale, bool negative )
+	: m_coefficient( coefficient ),
+	  m_scale( scale ),
+	  m_negative( negative && !coefficient.is_zero( ) )
+{
+	if( scale > max_scale )
+		throw data_exception( "Invalid decimal scale: " + std::to_string( scale ) );
+}
+
+inline decimal::decimal( std::string_view text )
+{
+	if( text.size( ) == 3 && ( text[ 0 ] | 0x20 ) == 'n' && ( text[ 1 ] | 0x20 ) == 'a' &&
+		( text[ 2 ] | 0x20 ) == 'n' )
+	{
+		m_nan = true;
+		return;
+	}
+
+	size_t pos = 0;
+	if( pos < text.size( ) && ( text[ pos ] == '-' || text[ pos ] == '+' ) )
+		m_negative = text[ pos++ ] == '-';
+
+	size_t digits = 0;
+	bool point = false;
+	for( ; pos < text.size( ); ++pos )
+	{
+		const char c = text[ pos ];
+		if( c == '.' && !point )
+			point = true;
+		else if( c >= '0' && c <= '9' )
+		{
+			if( !m_coefficient.mul_add( 10, c - '0' ) )
+				throw data_exception( "Decimal overflow: " + std::string( text ) );
+			m_scale += point;
+			++digits;
+		}
+		else
+			break;
+	}
+
+	if( pos != text.size( ) || digits == 0 || m_scale > max_scale )
+		throw data_exception( "Invalid decimal: " + std::string( text ) );
+	m_negative &= !m_coefficient.is_zero( );
+}
+
+inline decimal decimal::nan( )
+{
+	decimal value;
+	value.m_nan = true;
+	return value;
+}
+
+inline bool decimal::is_nan( ) const
+{
+	return m_nan;
+}
+
+inline bool decimal::is_negative( ) const
+{
+	return m_negative;
+}
+
+inline bool decimal::is_zero( ) const
+{
+	return !m_nan && m_coefficient.is_zero( );
+}
+
+inline uint16_t decimal::scale( ) const
+{
+	return m_scale;
+}
+
+inline const decimal::uint128& decimal::coefficient( ) const
+{
+	return m_coefficient;
+}
+
+inline decimal decimal::rescale( uint16_t scale ) const
+{
+	if( m_nan || scale == m_scale )
+		return *this;
+	if( scale > max_scale )
+		throw data_exception( "Invalid decimal scale: " + std::to_string( scale ) );
+
+	uint128 coefficient( m_coefficient );
+	if( scale > m_scale )
+	{
+		if( !coefficient.mul_pow10( scale - m_scale ) )
+			throw data_exception( "Decimal overflow: " + to_string( ) );
+	}
+	else
+		coefficient.div_pow10( m_scale - scale );
+	return decimal( coefficient, scale, m_negative );
+}
+
+inline double decimal::to_double( ) const
+{
+	static constexpr double pow10d[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+										 1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+										 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22, 1e23,
+										 1e24, 1e25, 1e26, 1e27, 1e28, 1e29, 1e30, 1e31,
+										 1e32, 1e33, 1e34, 1e35, 1e36, 1e37, 1e38 };
+	if( m_nan )
+		return std::numeric_limits< double >::quiet_NaN( );
+
+	const double value =
+		( ( double )m_coefficient.high * 18446744073709551616.0 + ( double )m_coefficient.low ) /
+		pow10d[ m_scale ];
+	return m_negative ? -value : value;
+}
+
+inline std::string decimal::to_string( ) const
+{
+	if( m_nan )
+		return "NaN";
+
+	// digits are produced nine at a time from the least significant end
+	char digits[ 48 ];
+	char* end = digits + sizeof( digits );
+	char* out = end;
+	uint128 coefficient( m_coefficient );
+	do
+	{
+		uint32_t chunk = coefficient.div_mod( pow10[ 9 ] );
+		char* chunkEnd = out - 9;
+		while( out > chunkEnd )
+		{
+			*--out = ( char )( '0' + chunk % 10 );
+			chunk /= 10;
+		}
+	} while( !coefficient.is_zero( ) || out > end - m_scale - 1 );
+
+	while( out < end - m_scale - 1 && *out == '0' )
+		++out;
+
+	std::string text;
+	text.reserve( ( end - out ) + 2 );
+	if( m_negative )
+		text.push_back( '-' );
+	text.append( out, end - m_scale );
+	if( m_scale )
+	{
+		text.push_back( '.' );
+		text.append( end - m_scale, end );
+	}
+	return text;
+}
+
+inline int decimal::compare( const decimal& other ) const
+{
+	if( m_negative != other.m_negative )
+		return m_negative ? -1 : 1;
+
+	// a coefficient overflowing when aligned to the other scale has the larger magnitude
+	int magnitude;
+	if( m_scale == other.m_scale )
+		magnitude = m_coefficient.compare( other.m_coefficient );
+	else if( m_scale < other.m_scale )
+	{
+		uint128 aligned( m_coefficient );
+		magnitude = aligned.mul_pow10( other.m_scale - m_scale )
+						? aligned.compare( other.m_coefficient )
+						: 1;
+	}
+	else
+	{
+		uint128 aligned( other.m_coefficient );
+		magnitude = aligned.mul_pow10( m_scale - other.m_scale )
+						? m_coefficient.compare( aligned )
+						: -1;
+	}
+	return m_negative ? -magnitude : magnitude;
+}
+
+inline bool decimal::operator==( const decimal& other ) const
+{
+	return !m_nan && !other.m_nan && compare( other ) == 0;
+}
+
+inline bool decimal::operator!=( const decimal& other ) const
+{
+	return !( *this == other );
+}
+
+inline bool decimal::operator<( const decimal& other ) const
+{
+	return !m_nan && !other.m_nan && compare( other ) < 0;
+}
+
+inline bool decimal::operator>( const decimal& other ) const
+{
+	return other < *this;
+}
+
+inline bool decimal::operator<=( const decimal& other ) const
+{
+	return !m_nan && !other.m_nan && compare( other ) <= 0;
+}
+
+inline bool decimal::operator>=( const decimal& other ) const
+{
+	return other <= *this;
+}
+
+}  // namespace dbclt
@@ -0,0 +1,91 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+namespace dbclt
+{
+// a fixed set of sessions, each pinned to its own worker thread
+//
+// tasks are spread round robin over the workers' queues, a worker running out of tasks steals
+// from the back of the others' queues. every task runs on the worker's own session so its
+// prepared statements and caches stay warm.
+template< typename BE >
+class executor
+{
+public:
+	using session_type = session< BE >;
+	using setup_type = std::function< void( session_type& ) >;
+
+public:
+	// connects every session, setup runs on each one right after it is connected
+	executor( const std::string& connInfo, size_t workers = 0, setup_type setup = nullptr );
+	~executor( );
+
+	size_t size( ) const;
+
+	// runs task( session_type& ) on one of the sessions
+	template< typename F >
+	std::future< std::invoke_result_t< F&, session_type& > > submit( F&& task );
+
+	// the parameters are copied, rows are converted on the worker so no result is left
+	// pointing at a connection it does not own anymore
+	template< typename... col_types >
+	std::future< size_t > execute( const std::string& stmt, col_types&&... values );
+
+	template< typename Row, typename... col_types >
+	std::future< std::vector< Row > > query( const std::string& stmt, col_types&&... values );
+
+private:
+	using task = std::function< void( session_type& ) >;
+
+	struct worker
+	{
+		std::mutex mutex;
+		std::condition_variable wake;
+		std::deque< task > tasks;
+		std::atomic< bool > busy { false };
+		session_type session;
+		std::thread thread;
+	};
+
+	void post( task t );
+	void run( worker& self, std::promise< void >& connected, const std::string& connInfo );
+	bool pop( worker& self, task& t );
+	bool steal( worker& self, task& t );
+	void stop( );
+
+private:
+	std::vector< std::unique_ptr< worker > > m_workers;
+	std::atomic< size_t > m_next { 0 };
+	std::atomic< size_t > m_queued { 0 };
+	std::atomic< bool > m_stop { false };
+	setup_type m_setup;
+
+private:
+	executor( const executor& ) = delete;
+	executor& operator=( const executor& ) = delete;
+};
+
+}  // namespace dbclt
@@ -0,0 +1,265 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+namespace dbclt
+{
+namespace detail
+{
+// parameters outlive the call, string literals are kept as strings
+template< typename T >
+inline auto stored_param( T&& value )
+{
+	if constexpr( std::is_convertible_v< std::decay_t< T >, const char* > )
+		return std::string( value );
+	else
+		return std::decay_t< T >( std::forward< T >( value ) );
+}
+}  // namespace detail
+
+template< typename BE >
+inline executor< BE >::executor( const std::string& connInfo, size_t workers, setup_type setup )
+	: m_setup( std::move( setup ) )
+{
+	if( workers == 0 )
+		workers = std::max< size_t >( std::thread::hardware_concurrency( ), 1 );
+
+	// the sessions connect concurrently, each on the thread that will use it
+	std::vector< std::promise< void > > connected( workers );
+	for( size_t i = 0; i < workers; ++i )
+	{
+		m_workers.emplace_back( std::make_unique< worker >( ) );
+		worker& w = *m_workers.back( );
+		std::promise< void >& promise = connected[ i ];
+		w.thread =
+			std::thread( [ this, &w, &promise, connInfo ]( ) { run( w, promise, connInfo ); } );
+	}
+
+	std::exception_ptr error;
+	for( auto& promise : connected )
+	{
+		try
+		{
+			promise.get_future( ).get( );
+		}
+		catch( ... )
+		{
+			if( !error )
+				error = std::current_exception( );
+		}
+	}
+
+	if( error )
+	{
+		stop( );
+		std::rethrow_exception( error );
+	}
+}
+
+template< typename BE >
+inline executor< BE >::~executor( )
+{
+	stop( );
+}
+
+template< typename BE >
+inline size_t executor< BE >::size( ) const
+{
+	return m_workers.size( );
+}
+
+template< typename BE >
+template< typename F >
+inline std::future< std::invoke_result_t< F&, typename executor< BE >::session_type& > >
+executor< BE >::submit( F&& t )
+{
+	using R = std::invoke_result_t< F&, session_type& >;
+	auto packaged =
+		std::make_shared< std::packaged_task< R( session_type& ) > >( std::forward< F >( t ) );
+	std::future< R > future = packaged->get_future( );
+	post( [ packaged ]( session_type& session ) { ( *packaged )( session ); } );
+	return future;
+}
+
+template< typename BE >
+template< typename... col_types >
+inline std::future< size_t > executor< BE >::execute( const std::string& stmt,
+													  col_types&&... values )
+{
+	auto params = std::make_tuple( detail::stored_param( std::forward< col_types >( values ) )... );
+	return submit( [ stmt, params = std::move( params ) ]( session_type& session ) mutable {
+		if constexpr( sizeof...( col_types ) == 0 )
+			return session.execute( stmt ).affected_count( );
+		else
+			return std::apply(
+				[ & ]( auto&... v ) { return session.execute_params( stmt, v... ); }, params )
+				.affected_count( );
+	} );
+}
+
+template< typename BE >
+template< typename Row, typename... col_types >
+inline std::future< std::vector< Row > > executor< BE >::query( const std::string& stmt,
+																col_types&&... values )
+{
+	auto params = std::make_tuple( detail::stored_param( std::forward< col_types >( values ) )... );
+	return submit( [ stmt, params = std::move( params ) ]( session_type& session ) mutable {
+		std::vector< Row > rows;
+		if constexpr( sizeof...( col_types ) == 0 )
+			session.query( stmt ).into( rows );
+		else
+			std::apply( [ & ]( auto&... v ) { session.query_params( stmt, v... ).into( rows ); },
+						params );
+		return rows;
+	} );
+}
+
+template< typename BE >
+inline void executor< BE >::post( task t )
+{
+	if( m_stop )
+		throw data_exception( "Executor is stopped" );
+
+	worker& target = *m_workers[ m_next++ % m_workers.size( ) ];
+	{
+		std::lock_guard< std::mutex > lock( target.mutex );
+		target.tasks.push_back( std::move( t ) );
+		++m_queued;
+	}
+	target.wake.notify_one( );
+
+	// a busy target leaves the task to the first idle worker
+	if( !target.busy )
+		return;
+
+	for( auto& w : m_workers )
+	{
+		if( w->busy )
+			continue;
+
+		{
+			std::lock_guard< std::mutex > lock( w->mutex );
+		}
+		w->wake.notify_one( );
+		break;
+	}
+}
+
+template< typename BE >
+inline void executor< BE >::run( worker& self,
+								 std::promise< void >& connected,
+								 const std::string& connInfo )
+{
+	try
+	{
+		self.session.connect( connInfo );
+		if( m_setup )
+			m_setup( self.session );
+		connected.set_value( );
+	}
+	catch( ... )
+	{
+		connected.set_exception( std::current_exception( ) );
+		return;
+	}
+
+	// queued tasks are completed before stopping so no future is left hanging
+	for( ;; )
+	{
+		task t;
+		if( pop( self, t ) || steal( self, t ) )
+		{
+			self.busy = true;
+			t( self.session );
+			self.busy = false;
+			continue;
+		}
+
+		std::unique_lock< std::mutex > lock( self.mutex );
+		if( m_stop && m_queued == 0 )
+			return;
+
+		// woken up for a task of its own or one to steal, the timeout covers a missed wake up
+		self.wake.wait_for( lock, std::chrono::milliseconds( 10 ), [ this, &self ]( ) {
+			return m_stop || m_queued > 0;
+		} );
+	}
+}
+
+template< typename BE >
+inline bool executor< BE >::pop( worker& self, task& t )
+{
+	std::lock_guard< std::mutex > lock( self.mutex );
+	if( self.tasks.empty( ) )
+		return false;
+
+	t = std::move( self.tasks.front( ) );
+	self.tasks.pop_front( );
+	--m_queued;
+	return true;
+}
+
+template< typename BE >
+inline bool executor< BE >::steal( worker& self, task& t )
+{
+	if( m_queued == 0 )
+		return false;
+
+	for( auto& victim : m_workers )
+	{
+		if( victim.get( ) == &self )
+			continue;
+
+		std::unique_lock< std::mutex > lock( victim->mutex, std::try_to_lock );
+		if( !lock || victim->tasks.empty( ) )
+			continue;
+
+		t = std::move( victim->tasks.back( ) );
+		victim->tasks.pop_back( );
+		--m_queued;
+		return true;
+	}
+
+	return false;
+}
+
+template< typename BE >
+inline void executor< BE >::stop( )
+{
+	m_stop = true;
+	for( auto& w : m_workers )
+	{
+		{
+			std::lock_guard< std::mutex > lock( w->mutex );
+		}
+		w->wake.notify_all( );
+	}
+
+	for( auto& w : m_workers )
+		if( w->thread.joinable( ) )
+			w->thread.join( );
+}
+
+}  // namespace dbclt
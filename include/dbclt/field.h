@@ -41,7 +41,11 @@ public:
 		db_double,
 		db_binary,
 		db_date,
-		db_datetime
+		db_datetime,
+		db_time,
+		db_interval,
+		db_uuid,
+		db_inet
 	};
 
 public:
@@ -58,6 +62,23 @@ private:
 
 using fields_type = std::vector< field >;
 
+namespace detail
+{
+// types without a common binary layout, their values are read as text with get_string( )
+inline bool is_formatted( field::type type )
+{
+	switch( type )
+	{
+	case field::type::db_time:
+	case field::type::db_interval:
+	case field::type::db_uuid:
+	case field::type::db_inet: return true;
+	default: return false;
+	}
+}
+
+}  // namespace detail
+
 inline field::field( )
 {
 }
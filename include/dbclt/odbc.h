@@ -25,13 +25,25 @@ SOFTWARE.
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstring>
 #include <date/date.h>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iterator>
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
 #include <set>
+#include <thread>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include <sql.h>
@@ -41,26 +53,40 @@ SOFTWARE.
 #include "field.h"
 #include "range.h"
 #include "util.h"
+#include "writer.h"
 
 #include "record.h"
 #include "recordset.h"
 #include "result.h"
+#include "typed_recordset.h"
 
 #include "session.h"
 #include "statement.h"
 #include "transaction.h"
+#include "executor.h"
+
+#include "arrow.h"
+#include "snapshot_writer.h"
 
 #include "odbc/common.h"
+#include "odbc/async.h"
+#include "odbc/row_binding.h"
 #include "odbc/result.h"
 #include "odbc/session.h"
+#include "odbc/pool.h"
 #include "odbc/statement.h"
 
+#include "odbc/async.inl"
+#include "odbc/row_binding.inl"
 #include "odbc/result.inl"
 #include "odbc/session.inl"
+#include "odbc/pool.inl"
 #include "odbc/statement.inl"
 
+#include "executor.inl"
 #include "recordset.inl"
 #include "result.inl"
 #include "session.inl"
 #include "statement.inl"
 #include "transaction.inl"
+#include "typed_recordset.inl"
@@ -0,0 +1,62 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+namespace dbclt
+{
+namespace odbc
+{
+// polls asynchronous statements on a few threads, an operation is posted again until it reports
+// its completion so many statements can be in flight without each holding a thread
+class async_scheduler
+{
+public:
+	using operation = std::function< bool( ) >;
+
+public:
+	explicit async_scheduler( size_t threads = 2 );
+	~async_scheduler( );
+
+	async_scheduler( const async_scheduler& ) = delete;
+	async_scheduler& operator=( const async_scheduler& ) = delete;
+
+	void post( operation op );
+	size_t pending( ) const;
+
+	static async_scheduler& instance( );
+
+private:
+	void run( );
+
+private:
+	mutable std::mutex m_mutex;
+	std::condition_variable m_cond;
+	std::deque< operation > m_operations;
+	std::vector< std::thread > m_threads;
+	bool m_stop { false };
+};
+
+}  // namespace odbc
+}  // namespace dbclt
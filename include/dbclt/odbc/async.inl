@@ -0,0 +1,112 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+namespace dbclt
+{
+namespace odbc
+{
+inline async_scheduler::async_scheduler( size_t threads )
+{
+	for( size_t i = 0; i < std::max< size_t >( threads, 1 ); ++i )
+		m_threads.emplace_back( [ this ]( ) { run( ); } );
+}
+
+inline async_scheduler::~async_scheduler( )
+{
+	{
+		std::lock_guard< std::mutex > lock( m_mutex );
+		m_stop = true;
+	}
+	m_cond.notify_all( );
+
+	for( auto& thread : m_threads )
+		thread.join( );
+}
+
+inline void async_scheduler::post( operation op )
+{
+	{
+		std::lock_guard< std::mutex > lock( m_mutex );
+		m_operations.push_back( std::move( op ) );
+	}
+	m_cond.notify_one( );
+}
+
+inline size_t async_scheduler::pending( ) const
+{
+	std::lock_guard< std::mutex > lock( m_mutex );
+	return m_operations.size( );
+}
+
+inline async_scheduler& async_scheduler::instance( )
+{
+	static async_scheduler scheduler;
+	return scheduler;
+}
+
+inline void async_scheduler::run( )
+{
+	constexpr auto pollInterval = std::chrono::milliseconds( 1 );
+
+	// operations still executing after a whole round wait a bit before being polled again
+	size_t misses = 0;
+	for( ;; )
+	{
+		operation op;
+		{
+			std::unique_lock< std::mutex > lock( m_mutex );
+			m_cond.wait( lock, [ this ]( ) { return m_stop || !m_operations.empty( ); } );
+
+			// pending operations are completed before stopping so no future is left hanging
+			if( m_operations.empty( ) )
+				return;
+
+			if( misses >= m_operations.size( ) )
+			{
+				misses = 0;
+				lock.unlock( );
+				std::this_thread::sleep_for( pollInterval );
+				continue;
+			}
+
+			op = std::move( m_operations.front( ) );
+			m_operations.pop_front( );
+		}
+
+		if( op( ) )
+		{
+			misses = 0;
+			continue;
+		}
+
+		++misses;
+		std::lock_guard< std::mutex > lock( m_mutex );
+		m_operations.push_back( std::move( op ) );
+	}
+}
+
+}  // namespace odbc
+}  // namespace dbclt
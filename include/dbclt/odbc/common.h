@@ -64,6 +64,126 @@ using env_ptr = std::shared_ptr< sql_handle< HENV, SQL_HANDLE_ENV > >;
 using conn_ptr = std::shared_ptr< sql_handle< HDBC, SQL_HANDLE_DBC > >;
 using statement_ptr = std::shared_ptr< sql_handle< HSTMT, SQL_HANDLE_STMT > >;
 
+// cache line aligned memory for bound columns, grows but never shrinks and keeps no content
+class binding_arena
+{
+public:
+	static constexpr size_t alignment = 64;
+
+	binding_arena( ) = default;
+	binding_arena( binding_arena&& other ) noexcept
+		: m_data( std::move( other.m_data ) ),
+		  m_size( std::exchange( other.m_size, 0 ) )
+	{
+	}
+
+	binding_arena& operator=( binding_arena&& other ) noexcept
+	{
+		m_data = std::move( other.m_data );
+		m_size = std::exchange( other.m_size, 0 );
+		return *this;
+	}
+
+	static size_t align( size_t size )
+	{
+		return ( size + alignment - 1 ) & ~( alignment - 1 );
+	}
+
+	char* reserve( size_t size )
+	{
+		if( size > m_size )
+		{
+			m_data.reset(
+				( char* )::operator new( align( size ), std::align_val_t( alignment ) ) );
+			m_size = align( size );
+		}
+		return m_data.get( );
+	}
+
+	char* data( ) const
+	{
+		return m_data.get( );
+	}
+
+	size_t size( ) const
+	{
+		return m_size;
+	}
+
+private:
+	struct deleter
+	{
+		void operator( )( char* p ) const
+		{
+			::operator delete( p, std::align_val_t( alignment ) );
+		}
+	};
+
+	std::unique_ptr< char, deleter > m_data;
+	size_t m_size { 0 };
+};
+
+// timestamp fractions are expressed in nanoseconds
+inline std::chrono::microseconds time_of_day( const SQL_TIMESTAMP_STRUCT& ts )
+{
+	return std::chrono::hours( ( int )ts.hour ) + std::chrono::minutes( ( int )ts.minute ) +
+		   std::chrono::seconds( ( int )ts.second ) +
+		   std::chrono::duration_cast< std::chrono::microseconds >(
+			   std::chrono::nanoseconds( ts.fraction ) );
+}
+
+inline datetime to_datetime( const SQL_TIMESTAMP_STRUCT& ts )
+{
+	return datetime( date::sys_days( date::year( ts.year ) / ts.month / ts.day ) +
+					 time_of_day( ts ) );
+}
+
+// converts a column of timestamps, the calendar day is only computed again when it changes
+inline void to_datetimes( const SQL_TIMESTAMP_STRUCT* ts,
+						  const SQLLEN* indicators,
+						  size_t count,
+						  datetime* dates )
+{
+	const SQL_TIMESTAMP_STRUCT* previous = nullptr;
+	date::sys_days day;
+	for( size_t i = 0; i < count; ++i )
+	{
+		if( indicators && indicators[ i ] == SQL_NULL_DATA )
+		{
+			dates[ i ] = datetime( );
+			continue;
+		}
+
+		if( !previous || ts[ i ].day != previous->day || ts[ i ].month != previous->month ||
+			ts[ i ].year != previous->year )
+		{
+			day = date::sys_days( date::year( ts[ i ].year ) / ts[ i ].month / ts[ i ].day );
+			previous = &ts[ i ];
+		}
+		dates[ i ] = datetime( day + time_of_day( ts[ i ] ) );
+	}
+}
+
+inline SQL_TIMESTAMP_STRUCT to_timestamp( const datetime& dt )
+{
+	const date::sys_days day = date::floor< date::days >( dt );
+	const date::year_month_day ymd( day );
+	std::chrono::microseconds time = dt - day;
+
+	SQL_TIMESTAMP_STRUCT ts;
+	ts.year = ( SQLSMALLINT )( int )ymd.year( );
+	ts.month = ( SQLUSMALLINT )( unsigned )ymd.month( );
+	ts.day = ( SQLUSMALLINT )( unsigned )ymd.day( );
+	ts.hour = ( SQLUSMALLINT )( time / std::chrono::hours( 1 ) );
+	time %= std::chrono::hours( 1 );
+	ts.minute = ( SQLUSMALLINT )( time / std::chrono::minutes( 1 ) );
+	time %= std::chrono::minutes( 1 );
+	ts.second = ( SQLUSMALLINT )( time / std::chrono::seconds( 1 ) );
+	time %= std::chrono::seconds( 1 );
+	ts.fraction = ( SQLUINTEGER )( time.count( ) * 1000 );
+	return ts;
+}
+
 template< typename Handle, SQLSMALLINT Type >
 inline sql_handle< Handle, Type >::~sql_handle( )
 {
@@ -0,0 +1,53 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "session.h"
+
+namespace dbclt
+{
+namespace odbc
+{
+// sessions sharing a pooled environment, the driver manager hands back a released physical
+// connection instead of opening a new one when the connection string matches
+class connection_pool
+{
+public:
+	explicit connection_pool( const std::string& connInfo );
+
+	// opens count physical connections in parallel and releases them into the pool
+	void open( size_t count );
+
+	session connect( ) const;
+
+	const std::string& connection_string( ) const;
+
+private:
+	std::string m_connInfo;
+	env_ptr m_env;
+};
+
+}  // namespace odbc
+}  // namespace dbclt
@@ -0,0 +1,85 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+namespace dbclt
+{
+namespace odbc
+{
+inline connection_pool::connection_pool( const std::string& connInfo )
+	: m_connInfo( connInfo )
+	, m_env( session_impl::shared_environment( true ) )
+{
+}
+
+inline void connection_pool::open( size_t count )
+{
+	std::vector< session_impl > sessions( count );
+	std::vector< std::exception_ptr > errors( count );
+	std::vector< std::thread > threads;
+	threads.reserve( count );
+
+	for( size_t i = 0; i < count; ++i )
+	{
+		threads.emplace_back( [ this, &sessions, &errors, i ]( ) {
+			try
+			{
+				sessions[ i ].set_environment( m_env );
+				sessions[ i ].connect( m_connInfo );
+			}
+			catch( ... )
+			{
+				errors[ i ] = std::current_exception( );
+			}
+		} );
+	}
+	for( auto& thread : threads )
+		thread.join( );
+
+	// disconnecting hands the physical connections back to the driver manager
+	sessions.clear( );
+
+	for( auto& error : errors )
+	{
+		if( error )
+			std::rethrow_exception( error );
+	}
+}
+
+inline session connection_pool::connect( ) const
+{
+	session s;
+	s.backend( ).set_environment( m_env );
+	s.connect( m_connInfo );
+	return s;
+}
+
+inline const std::string& connection_pool::connection_string( ) const
+{
+	return m_connInfo;
+}
+
+}  // namespace odbc
+}  // namespace dbclt
@@ -54,9 +54,29 @@ public:
 	using recordset_iterator = dbclt::recordset_iterator< result_impl, bool >;
 	using recordset_type = dbclt::recordset< result_impl >;
 
+	struct col_desc
+	{
+		SQLUSMALLINT pos;
+		std::string columnName;
+		SQLSMALLINT dataType;
+		SQLULEN columnSize;
+		SQLSMALLINT decimalDigits;
+		SQLSMALLINT nullable;
+	};
+
+	// layout of a statement's first result set, kept between its executions
+	struct column_cache
+	{
+		std::vector< col_desc > columns;
+		binding_arena arena;
+	};
+	using column_cache_ptr = std::shared_ptr< column_cache >;
+
 public:
 	result_impl( ) = default;
-	static std::shared_ptr< result_impl > create( statement_ptr stmt );
+	~result_impl( );
+	static std::shared_ptr< result_impl >
+	create( statement_ptr stmt, size_t rowArraySize = 1, column_cache_ptr cache = nullptr );
 
 	size_t affected_count( ) const;
 	int return_value( ) const;
@@ -81,6 +101,7 @@ public:
 	bool is_null( size_t field ) const;
 
 	std::string get_string( size_t ndxField ) const;
+	std::string_view get_string_view( size_t ndxField ) const;
 	bool get_bool( size_t ndxField ) const;
 	int8_t get_int8( size_t ndxField ) const;
 	int16_t get_int16( size_t ndxField ) const;
@@ -88,18 +109,25 @@ public:
 	int64_t get_int64( size_t ndxField ) const;
 	float get_float( size_t ndxField ) const;
 	double get_double( size_t ndxField ) const;
+	datetime get_date( size_t ndxField ) const;
 	datetime get_datetime( size_t ndxField ) const;
 
+	// streams a long field to callback( const char* data, size_t size ) without keeping it,
+	// returns false when the field is null
+	template< typename F >
+	bool read_blob( size_t ndxField, F&& callback );
+
+	// fetches the remaining rows straight into the members of the container's value type
+	template< typename T >
+	bool bulk_into( T& container );
+
 private:
-	struct col_desc
+	// unbound long columns are read with SQLGetData on first access only
+	enum class long_state
 	{
-		SQLUSMALLINT pos;
-		SQLCHAR columnName[ 2048 ];
-		SQLSMALLINT nameLength;
-		SQLSMALLINT dataType;
-		SQLULEN columnSize;
-		SQLSMALLINT decimalDigits;
-		SQLSMALLINT nullable;
+		pending,
+		fetched,
+		streamed
 	};
 
 	struct record_data
@@ -107,60 +135,75 @@ private:
 		bool bound;
 		SQLSMALLINT cDataType;
 		SQLULEN dataSize;
-		void* value;
-		void* typedBindings;
-		size_t ndxValue;
+		char* value;
+		size_t ndxData;  // of the long data buffer or the timestamp cache
+		SQLLEN* indicators;
+		long_state state;
 	};
-	std::vector< int8_t > m_int8Bindings;
-	std::vector< int16_t > m_int16Bindings;
-	std::vector< int32_t > m_int32Bindings;
-	std::vector< int64_t > m_int64Bindings;
-	std::vector< double > m_dblBindings;
-	struct timestamp_binding
+
+	// timestamps are converted a whole block at a time on the column's first access
+	struct timestamp_cache
 	{
-		SQL_TIMESTAMP_STRUCT ts;
-		datetime date;
+		std::vector< datetime > dates;
+		size_t block { 0 };
 	};
-	std::vector< std::pair< size_t, timestamp_binding > > m_tsBindings;
 
-	std::vector< std::pair< size_t, std::vector< char > > > m_strBindings;
-	std::vector< std::pair< size_t, std::vector< char > > > m_binBindings;
+	// bound values column after column, each on its own cache lines, then all the indicators
+	binding_arena m_arena;
+	mutable std::vector< std::vector< char > > m_longData;
+	mutable std::vector< timestamp_cache > m_tsCache;
 
 private:
 	void check_stmt_error( SQLRETURN rc );
 	void init( std::shared_ptr< result_impl > ptr, statement_ptr stmt );
 
 	void init_record_data( );
+	std::vector< col_desc > describe_columns( SQLSMALLINT fields );
+	bool same_shape( const std::vector< col_desc >& colDescs ) const;
+	bool same_types( const std::vector< col_desc >& colDescs );
+	void bind_columns( std::vector< col_desc > colDescs );
+	void init_row_array( const std::vector< col_desc >& colDescs );
+	bool fetch_record( );
 	void get_record_data( );
-	void get_record_data_string( );
-	void get_record_data_binary( );
-	void get_record_data_timestamp( );
+	void fetch_long_data( size_t field ) const;
+	void fetch_long_data_before( size_t field ) const;
+	std::vector< char >& long_data_buffer( const record_data& recordData ) const;
 
-	template< typename binding_type >
-	const record_data& data( size_t field, const binding_type& bindings ) const;
+	const record_data& data( size_t field, SQLSMALLINT cDataType ) const;
+	const char* value( const record_data& recordData ) const;
+
+	template< typename T >
+	T bound_value( size_t field, SQLSMALLINT cDataType ) const;
 
 	SQLSMALLINT target_type( SQLSMALLINT sqlType ) const;
 
-	template< typename binding_type >
-	void grow_typed_binding( binding_type& bindings );
-	void grow_typed_binding( SQLSMALLINT sqlType );
 	void init_typed_binding( col_desc& cd );
-
-	static field::type map_db_type( SQLSMALLINT dataType );
-
-	template< typename binding_type >
 	void set_typed_binding( const col_desc& cd,
 							bool bound,
 							SQLSMALLINT cDataType,
-							binding_type& bindings );
+							SQLULEN dataSize );
+
+	static field::type map_db_type( SQLSMALLINT dataType );
+	static size_t binding_size( const col_desc& cd );
 
 private:
 	statement_ptr m_stmt;
 	fields_type m_fields;
-	std::vector< record_data > m_recordData;
+	std::vector< col_desc > m_colDescs;
+	column_cache_ptr m_cache;
+	column_cache_ptr m_arenaOwner;
+	mutable std::vector< record_data > m_recordData;
 
 	size_t m_records { 0 };
 	bool m_eof { false };
+
+	// block cursor, rows are walked within a block before fetching the next one
+	size_t m_maxRowArraySize { 1 };
+	size_t m_rowArraySize { 1 };
+	size_t m_row { 0 };
+	size_t m_block { 0 };
+	SQLULEN m_rowsFetched { 0 };
+	std::vector< SQLUSMALLINT > m_rowStatus;
 };
 
 }  // namespace odbc
@@ -28,13 +28,32 @@ namespace dbclt
 {
 namespace odbc
 {
-inline std::shared_ptr< result_impl > result_impl::create( statement_ptr stmt )
+inline std::shared_ptr< result_impl >
+result_impl::create( statement_ptr stmt, size_t rowArraySize, column_cache_ptr cache )
 {
 	std::shared_ptr< result_impl > ptr( std::make_shared< result_impl >( ) );
+	ptr->m_maxRowArraySize = std::max< size_t >( rowArraySize, 1 );
+	ptr->m_cache = cache;
 	ptr->init( ptr, stmt );
 	return ptr;
 }
 
+inline result_impl::~result_impl( )
+{
+	// the handle may be reused from the prepared statement cache, nothing may point back here
+	if( m_stmt && *m_stmt != SQL_NULL_HANDLE )
+	{
+		SQLFreeStmt( *m_stmt, SQL_CLOSE );
+		SQLFreeStmt( *m_stmt, SQL_UNBIND );
+		SQLSetStmtAttr( *m_stmt, SQL_ATTR_ROW_STATUS_PTR, nullptr, 0 );
+		SQLSetStmtAttr( *m_stmt, SQL_ATTR_ROWS_FETCHED_PTR, nullptr, 0 );
+	}
+
+	// nothing is bound anymore, the next execution of the statement takes the arena over
+	if( m_arenaOwner && m_arena.size( ) > m_arenaOwner->arena.size( ) )
+		m_arenaOwner->arena = std::move( m_arena );
+}
+
 inline void result_impl::check_stmt_error( SQLRETURN rc )
 {
 	session_impl::check_stmt_error( rc, *m_stmt );
@@ -101,7 +120,28 @@ inline result_impl::recordsets_type result_impl::create_recordsets( recordset_ty
 
 inline void result_impl::next_recordset( recordsets_value_type*& data )
 {
-	data = nullptr;
+	// statements of a batch without a result set are skipped
+	for( ;; )
+	{
+		SQLRETURN rc = SQLMoreResults( *m_stmt );
+		if( rc == SQL_NO_DATA )
+		{
+			data = nullptr;
+			return;
+		}
+		check_stmt_error( rc );
+
+		SQLSMALLINT fields;
+		check_stmt_error( SQLNumResultCols( *m_stmt, &fields ) );
+		if( fields > 0 )
+			break;
+	}
+
+	SQLLEN rowCount;
+	check_stmt_error( SQLRowCount( *m_stmt, &rowCount ) );
+	m_records = rowCount;
+
+	*data = create_recordset( );
 }
 
 inline result_impl::recordsets_value_type& result_impl::get_recordset( recordsets_value_type* data )
@@ -111,13 +151,34 @@ inline result_impl::recordsets_value_type& result_impl::get_recordset( recordset
 
 inline void result_impl::next_record( bool& data )
 {
-	SQLRETURN rc = SQLFetch( *m_stmt );
-	if( rc == SQL_NO_DATA )
-		data = false;
-	else
+	data = fetch_record( );
+}
+
+inline bool result_impl::fetch_record( )
+{
+	for( ;; )
 	{
-		check_stmt_error( rc );
-		get_record_data( );
+		if( ++m_row >= m_rowsFetched )
+		{
+			m_row = 0;
+			m_rowsFetched = 0;
+			SQLRETURN rc = SQLFetch( *m_stmt );
+			if( rc == SQL_NO_DATA )
+				return false;
+			check_stmt_error( rc );
+			if( m_rowsFetched == 0 )
+				return false;
+			++m_block;
+		}
+
+		switch( m_rowStatus[ m_row ] )
+		{
+		case SQL_ROW_NOROW:
+		case SQL_ROW_DELETED: break;
+		case SQL_ROW_ERROR:
+			throw data_exception( "Cannot fetch record: " + std::to_string( m_row ) );
+		default: get_record_data( ); return true;
+		}
 	}
 }
 
@@ -132,259 +193,535 @@ inline bool result_impl::is_null( size_t field ) const
 	if( field >= m_fields.size( ) )
 		throw data_exception( "Invalid field index" );
 
-	return m_recordData[ field ].dataSize == SQL_NULL_DATA;
+	if( !m_recordData[ field ].bound && m_recordData[ field ].state == long_state::pending )
+		fetch_long_data( field );
+
+	return m_recordData[ field ].indicators[ m_row ] == SQL_NULL_DATA;
 }
 
 inline std::string result_impl::get_string( size_t field ) const
 {
-	static const std::string empty;
-	const std::vector< char >& binding =
-		m_strBindings[ data( field, m_strBindings ).ndxValue ].second;
-	return binding.empty( ) ? empty : std::string( &*binding.begin( ) );
+	const record_data& recordData = data( field, SQL_C_CHAR );
+	fetch_long_data( field );
+	if( recordData.indicators[ m_row ] == SQL_NULL_DATA )
+		return std::string( );
+	return std::string( value( recordData ) );
+}
+
+inline std::string_view result_impl::get_string_view( size_t field ) const
+{
+	if( field < m_recordData.size( ) )
+		fetch_long_data( field );
+
+	if( field < m_recordData.size( ) && m_recordData[ field ].cDataType == SQL_C_BINARY )
+	{
+		const record_data& recordData = data( field, SQL_C_BINARY );
+		const size_t capacity = recordData.bound ? recordData.dataSize
+												 : m_longData[ recordData.ndxData ].size( );
+		const SQLLEN length = recordData.indicators[ m_row ];
+		const size_t size = length < 0 ? 0 : std::min( capacity, ( size_t )length );
+		return std::string_view( value( recordData ), size );
+	}
+
+	const record_data& recordData = data( field, SQL_C_CHAR );
+	if( recordData.indicators[ m_row ] == SQL_NULL_DATA )
+		return std::string_view( );
+	return std::string_view( value( recordData ) );
 }
 
 inline bool result_impl::get_bool( size_t field ) const
 {
-	return m_int8Bindings[ data( field, m_int8Bindings ).ndxValue ] != 0;
+	return bound_value< int8_t >( field, SQL_C_STINYINT ) != 0;
 }
 
 inline int8_t result_impl::get_int8( size_t field ) const
 {
-	return m_int8Bindings[ data( field, m_int8Bindings ).ndxValue ];
+	return bound_value< int8_t >( field, SQL_C_STINYINT );
 }
 
 inline int16_t result_impl::get_int16( size_t field ) const
 {
-	return m_int16Bindings[ data( field, m_int16Bindings ).ndxValue ];
+	return bound_value< int16_t >( field, SQL_C_SSHORT );
 }
 
 inline int32_t result_impl::get_int32( size_t field ) const
 {
-	return m_int32Bindings[ data( field, m_int32Bindings ).ndxValue ];
+	return bound_value< int32_t >( field, SQL_C_SLONG );
 }
 
 inline int64_t result_impl::get_int64( size_t field ) const
 {
-	return m_int64Bindings[ data( field, m_int64Bindings ).ndxValue ];
+	return bound_value< int64_t >( field, SQL_C_SBIGINT );
 }
 
 inline float result_impl::get_float( size_t field ) const
 {
-	return ( float )m_dblBindings[ data( field, m_dblBindings ).ndxValue ];
+	return ( float )bound_value< double >( field, SQL_C_DOUBLE );
 }
 
 inline double result_impl::get_double( size_t field ) const
 {
-	return m_dblBindings[ data( field, m_dblBindings ).ndxValue ];
+	return bound_value< double >( field, SQL_C_DOUBLE );
+}
+
+inline datetime result_impl::get_date( size_t field ) const
+{
+	return get_datetime( field );
 }
 
 inline datetime result_impl::get_datetime( size_t field ) const
 {
-	return m_tsBindings[ data( field, m_tsBindings ).ndxValue ].second.date;
+	const record_data& recordData = data( field, SQL_C_TYPE_TIMESTAMP );
+	timestamp_cache& cache = m_tsCache[ recordData.ndxData ];
+	if( cache.block != m_block )
+	{
+		cache.dates.resize( m_rowsFetched );
+		to_datetimes( ( const SQL_TIMESTAMP_STRUCT* )recordData.value,
+					  recordData.indicators,
+					  m_rowsFetched,
+					  cache.dates.data( ) );
+		cache.block = m_block;
+	}
+	return cache.dates[ m_row ];
 }
 
-inline void result_impl::init_record_data( )
+template< typename T >
+inline bool result_impl::bulk_into( T& container )
 {
-	m_recordData.clear( );
+	using row_type = typename T::value_type;
+	if constexpr( !is_row_bindable< row_type >( ) )
+		return false;
+	else
+	{
+		using Tup = decltype( structs::to_tuple( std::declval< row_type& >( ) ) );
+		if( std::tuple_size_v< Tup > != m_fields.size( ) )
+			return false;
+
+		std::vector< SQLULEN > stringSizes( m_fields.size( ), 0 );
+		for( size_t i = 0; i < m_recordData.size( ); ++i )
+		{
+			if( !m_recordData[ i ].bound )
+				return false;
+			if( m_recordData[ i ].cDataType == SQL_C_CHAR )
+				stringSizes[ i ] = m_recordData[ i ].dataSize;
+		}
+
+		if( m_eof )
+			return true;
+
+		// the block already fetched through the column bindings is converted first
+		recordset_value_type rec( shared_from_this( ) );
+		for( ;; )
+		{
+			row_type row;
+			convert( rec, row );
+			container.emplace_back( std::move( row ) );
+			if( m_row + 1 >= m_rowsFetched )
+				break;
+			if( !fetch_record( ) )
+			{
+				m_eof = true;
+				return true;
+			}
+		}
+
+		row_binding< row_type > binding( stringSizes, m_rowArraySize );
+		check_stmt_error( SQLFreeStmt( *m_stmt, SQL_UNBIND ) );
+		binding.bind( *m_stmt );
 
+		for( ;; )
+		{
+			m_rowsFetched = 0;
+			SQLRETURN rc = SQLFetch( *m_stmt );
+			if( rc == SQL_NO_DATA )
+				break;
+			check_stmt_error( rc );
+			if( m_rowsFetched == 0 )
+				break;
+
+			for( size_t r = 0; r < m_rowsFetched; ++r )
+			{
+				switch( m_rowStatus[ r ] )
+				{
+				case SQL_ROW_NOROW:
+				case SQL_ROW_DELETED: break;
+				case SQL_ROW_ERROR:
+					throw data_exception( "Cannot fetch record: " + std::to_string( r ) );
+				default: container.emplace_back( binding.get( r ) ); break;
+				}
+			}
+		}
+
+		check_stmt_error( SQLFreeStmt( *m_stmt, SQL_UNBIND ) );
+		check_stmt_error( SQLSetStmtAttr(
+			*m_stmt, SQL_ATTR_ROW_BIND_TYPE, ( SQLPOINTER )SQL_BIND_BY_COLUMN, 0 ) );
+		m_colDescs.clear( );
+		m_row = 0;
+		m_rowsFetched = 0;
+		m_eof = true;
+		return true;
+	}
+}
+
+inline void result_impl::init_record_data( )
+{
 	SQLSMALLINT fields;
 	check_stmt_error( SQLNumResultCols( *m_stmt, &fields ) );
 
-	std::vector< col_desc > colDescs( fields );
+	// a statement text executed before skips describing its first result set and reuses the
+	// arena of its previous execution, unless another connection changed its column types
+	std::vector< col_desc > colDescs;
+	if( m_cache && !m_cache->columns.empty( ) && m_cache->columns.size( ) == ( size_t )fields &&
+		same_types( m_cache->columns ) )
+		colDescs = m_cache->columns;
+	else
+	{
+		colDescs = describe_columns( fields );
+		if( m_cache )
+			m_cache->columns = colDescs;
+	}
+	if( m_cache )
+	{
+		if( m_cache->arena.size( ) > m_arena.size( ) )
+			m_arena = std::move( m_cache->arena );
+		m_arenaOwner = std::move( m_cache );
+	}
 
-	m_fields.resize( fields );
-	m_recordData.resize( fields );
+	// a result set shaped like the previous one keeps its buffers and column bindings
+	if( !m_colDescs.empty( ) && same_shape( colDescs ) )
+	{
+		for( SQLSMALLINT i = 0; i < fields; ++i )
+			m_fields[ i ] =
+				field( colDescs[ i ].columnName, map_db_type( colDescs[ i ].dataType ) );
+	}
+	else
+		bind_columns( colDescs );
+
+	m_row = 0;
+	m_rowsFetched = 0;
+	m_eof = !fetch_record( );
+}
+
+inline std::vector< result_impl::col_desc > result_impl::describe_columns( SQLSMALLINT fields )
+{
+	std::vector< col_desc > colDescs( fields );
+	std::vector< SQLCHAR > name( 256 );
 	for( SQLSMALLINT i = 0; i < fields; ++i )
 	{
 		col_desc& cd = colDescs[ i ];
 		cd.pos = i + 1;
-		check_stmt_error( SQLDescribeCol( *m_stmt,
-										  cd.pos,
-										  cd.columnName,
-										  sizeof( cd.columnName ),
-										  &cd.nameLength,
-										  &cd.dataType,
-										  &cd.columnSize,
-										  &cd.decimalDigits,
-										  &cd.nullable ) );
-
-		grow_typed_binding( cd.dataType );
+
+		// names longer than the buffer are described again with the reported length
+		SQLSMALLINT nameLength = 0;
+		for( ;; )
+		{
+			check_stmt_error( SQLDescribeCol( *m_stmt,
+											  cd.pos,
+											  name.data( ),
+											  ( SQLSMALLINT )name.size( ),
+											  &nameLength,
+											  &cd.dataType,
+											  &cd.columnSize,
+											  &cd.decimalDigits,
+											  &cd.nullable ) );
+			if( ( size_t )nameLength < name.size( ) )
+				break;
+			name.resize( nameLength + 1 );
+		}
+		cd.columnName.assign( ( const char* )name.data( ), nameLength );
 	}
 
-	for( SQLSMALLINT i = 0; i < fields; ++i )
+	return colDescs;
+}
+
+inline bool result_impl::same_shape( const std::vector< col_desc >& colDescs ) const
+{
+	if( colDescs.size( ) != m_colDescs.size( ) )
+		return false;
+
+	for( size_t i = 0; i < colDescs.size( ); ++i )
+		if( colDescs[ i ].dataType != m_colDescs[ i ].dataType ||
+			colDescs[ i ].columnSize != m_colDescs[ i ].columnSize ||
+			colDescs[ i ].decimalDigits != m_colDescs[ i ].decimalDigits )
+			return false;
+
+	return true;
+}
+
+inline bool result_impl::same_types( const std::vector< col_desc >& colDescs )
+{
+	// one attribute per column, and the length of the types declared with one since they are
+	// bound as text of that size
+	for( const col_desc& cd: colDescs )
+	{
+		SQLLEN value = 0;
+		check_stmt_error( SQLColAttribute(
+			*m_stmt, cd.pos, SQL_DESC_CONCISE_TYPE, nullptr, 0, nullptr, &value ) );
+		if( value != cd.dataType )
+			return false;
+
+		switch( cd.dataType )
+		{
+		case SQL_CHAR:
+		case SQL_VARCHAR:
+		case SQL_WCHAR:
+		case SQL_WVARCHAR:
+		case SQL_BINARY:
+		case SQL_VARBINARY:
+			check_stmt_error(
+				SQLColAttribute( *m_stmt, cd.pos, SQL_DESC_LENGTH, nullptr, 0, nullptr, &value ) );
+			if( ( SQLULEN )value != cd.columnSize )
+				return false;
+			break;
+		default: break;
+		}
+	}
+	return true;
+}
+
+inline void result_impl::bind_columns( std::vector< col_desc > colDescs )
+{
+	const size_t fields = colDescs.size( );
+	m_colDescs = colDescs;
+
+	check_stmt_error( SQLFreeStmt( *m_stmt, SQL_UNBIND ) );
+	m_longData.clear( );
+	m_tsCache.clear( );
+
+	m_fields.assign( fields, field( ) );
+	m_recordData.assign( fields, record_data( ) );
+
+	init_row_array( colDescs );
+
+	// the arena is laid out once for the whole block, values first then indicators
+	size_t size = 0;
+	std::vector< size_t > offsets( fields );
+	for( size_t i = 0; i < fields; ++i )
 	{
 		col_desc& cd = colDescs[ i ];
-		m_fields[ i ] = field( ( const char* )cd.columnName, map_db_type( cd.dataType ) );
+		m_fields[ i ] = field( cd.columnName, map_db_type( cd.dataType ) );
 
 		init_typed_binding( cd );
-
+		offsets[ i ] = size;
 		if( m_recordData[ i ].bound )
+			size += binding_arena::align( m_recordData[ i ].dataSize * m_rowArraySize );
+	}
+
+	const size_t indicatorsOffset = size;
+	size += fields * m_rowArraySize * sizeof( SQLLEN );
+	char* arena = m_arena.reserve( size );
+
+	for( size_t i = 0; i < fields; ++i )
+	{
+		record_data& recordData = m_recordData[ i ];
+		recordData.indicators = ( SQLLEN* )( arena + indicatorsOffset ) + i * m_rowArraySize;
+
+		if( recordData.bound )
 		{
+			recordData.value = arena + offsets[ i ];
 			check_stmt_error( SQLBindCol( *m_stmt,
-										  cd.pos,
-										  m_recordData[ i ].cDataType,
-										  m_recordData[ i ].value,
-										  m_recordData[ i ].dataSize,
-										  ( SQLLEN* )&m_recordData[ i ].dataSize ) );
+										  colDescs[ i ].pos,
+										  recordData.cDataType,
+										  recordData.value,
+										  recordData.dataSize,
+										  recordData.indicators ) );
 		}
 	}
+}
 
-	SQLRETURN rc = SQLFetch( *m_stmt );
-	if( rc == SQL_NO_DATA )
-		m_eof = true;
-	else
+inline void result_impl::init_row_array( const std::vector< col_desc >& colDescs )
+{
+	// keep a block within a few megabytes, long columns are read with SQLGetData which
+	// most drivers only support one row at a time
+	constexpr size_t maxBlockSize = 4 * 1024 * 1024;
+
+	m_rowArraySize = m_maxRowArraySize;
+	size_t rowSize = 0;
+	for( const col_desc& cd: colDescs )
 	{
-		check_stmt_error( rc );
-		m_eof = false;
-		get_record_data( );
+		if( cd.dataType == SQL_LONGVARCHAR || cd.dataType == SQL_LONGVARBINARY )
+			m_rowArraySize = 1;
+		rowSize += binding_size( cd ) + sizeof( SQLLEN );
+	}
+
+	m_rowArraySize = std::clamp< size_t >( maxBlockSize / std::max< size_t >( rowSize, 1 ),
+										   1,
+										   m_rowArraySize );
+
+	// always set, a reused handle keeps the array size of its previous result
+	if( !SQL_SUCCEEDED( SQLSetStmtAttr(
+			*m_stmt, SQL_ATTR_ROW_ARRAY_SIZE, ( SQLPOINTER )m_rowArraySize, 0 ) ) )
+	{
+		m_rowArraySize = 1;
+		SQLSetStmtAttr( *m_stmt, SQL_ATTR_ROW_ARRAY_SIZE, ( SQLPOINTER )m_rowArraySize, 0 );
 	}
+
+	// the driver may have lowered the array size
+	SQLULEN rowArraySize = m_rowArraySize;
+	if( SQL_SUCCEEDED( SQLGetStmtAttr(
+			*m_stmt, SQL_ATTR_ROW_ARRAY_SIZE, &rowArraySize, sizeof( rowArraySize ), nullptr ) ) &&
+		rowArraySize > 0 )
+		m_rowArraySize = std::min< size_t >( rowArraySize, m_rowArraySize );
+
+	m_rowStatus.assign( m_rowArraySize, SQL_ROW_SUCCESS );
+	check_stmt_error( SQLSetStmtAttr( *m_stmt, SQL_ATTR_ROW_STATUS_PTR, m_rowStatus.data( ), 0 ) );
+	check_stmt_error( SQLSetStmtAttr( *m_stmt, SQL_ATTR_ROWS_FETCHED_PTR, &m_rowsFetched, 0 ) );
 }
 
 inline void result_impl::get_record_data( )
 {
-	get_record_data_string( );
-	get_record_data_binary( );
-	get_record_data_timestamp( );
+	for( record_data& recordData: m_recordData )
+		if( !recordData.bound )
+			recordData.state = long_state::pending;
 }
 
-inline void result_impl::get_record_data_string( )
+inline std::vector< char >& result_impl::long_data_buffer( const record_data& recordData ) const
 {
-	constexpr size_t chunkSize = 64 * 1024;
-	// constexpr size_t chunkSize = 5;
-	constexpr size_t strChunkSize = chunkSize - 1;
-	using buffer = std::array< char, chunkSize >;
-	using buffers = std::list< buffer >;
+	std::vector< char >& buffer = m_longData[ recordData.ndxData ];
 
-	buffers bufs;
-	for( std::pair< size_t, std::vector< char > >& binding: m_strBindings )
-	{
-		record_data& recordData = m_recordData[ binding.first ];
-		if( !recordData.bound )
-		{
-			size_t totalSize = 0;
+	// reused across rows, only ever grows
+	constexpr size_t minSize = 64 * 1024;
+	if( buffer.size( ) < minSize )
+		buffer.resize( minSize );
+	return buffer;
+}
 
-			bufs.clear( );
-			SQLRETURN rc;
-			do
-			{
-				recordData.dataSize = chunkSize;
-				bufs.resize( bufs.size( ) + 1 );
-				rc = SQLGetData( *m_stmt,
-								 ( SQLUSMALLINT )binding.first + 1,
-								 recordData.cDataType,
-								 ( SQLPOINTER )bufs.back( ).data( ),
-								 chunkSize,
-								 ( SQLLEN* )&recordData.dataSize );
-				check_stmt_error( rc );
-
-				if( recordData.dataSize == SQL_NULL_DATA || rc == SQL_NO_DATA )
-					break;
-
-				if( recordData.dataSize > strChunkSize )
-					totalSize += strChunkSize;
-				else
-					totalSize += recordData.dataSize;
-			} while( rc != SQL_SUCCESS );
-
-			if( recordData.dataSize != SQL_NULL_DATA )
-			{
-				binding.second.resize( totalSize + 1 );
-				recordData.dataSize = totalSize;
-
-				size_t offset = 0;
-				for( const buffer& buf: bufs )
-					if( totalSize - offset > 0 )
-					{
-						memcpy( &binding.second[ offset ],
-								buf.data( ),
-								std::min( strChunkSize, totalSize - offset ) );
-						offset += strChunkSize;
-					}
-
-				binding.second[ totalSize ] = '\0';
-			}
-		}
-	}
+inline void result_impl::fetch_long_data_before( size_t field ) const
+{
+	// drivers may only return long data in column order, earlier columns are kept first
+	for( size_t i = 0; i < field; ++i )
+		if( !m_recordData[ i ].bound && m_recordData[ i ].state == long_state::pending )
+			fetch_long_data( i );
 }
 
-inline void result_impl::get_record_data_binary( )
+inline void result_impl::fetch_long_data( size_t field ) const
 {
-	constexpr size_t chunkSize = 64 * 1024;
-	using buffer = std::array< char, chunkSize >;
-	using buffers = std::list< buffer >;
+	record_data& recordData = m_recordData[ field ];
+	if( recordData.bound || recordData.state == long_state::fetched )
+		return;
+	if( recordData.state == long_state::streamed )
+		throw data_exception( "Field already streamed: " + m_fields[ field ].name( ) );
 
-	buffers bufs;
-	for( std::pair< size_t, std::vector< char > >& binding: m_binBindings )
-	{
-		record_data& recordData = m_recordData[ binding.first ];
-		if( !recordData.bound )
-		{
-			size_t totalSize = 0;
+	fetch_long_data_before( field );
 
-			bufs.clear( );
-			SQLRETURN rc = SQL_NULL_DATA;
-			do
-			{
-				bufs.resize( bufs.size( ) + 1 );
-				rc = SQLGetData( *m_stmt,
-								 ( SQLUSMALLINT )binding.first + 1,
-								 recordData.cDataType,
-								 ( SQLPOINTER )bufs.back( ).data( ),
-								 chunkSize,
-								 ( SQLLEN* )&recordData.dataSize );
-				check_stmt_error( rc );
-
-				if( recordData.dataSize == SQL_NULL_DATA || recordData.dataSize == SQL_NO_DATA )
-					break;
-
-				totalSize += recordData.dataSize;
-			} while( true );
-
-			if( recordData.dataSize != SQL_NULL_DATA )
-			{
-				binding.second.resize( totalSize );
+	std::vector< char >& buffer = long_data_buffer( recordData );
+	const size_t terminator = recordData.cDataType == SQL_C_CHAR ? 1 : 0;
+	SQLLEN& indicator = recordData.indicators[ 0 ];
 
-				size_t offset = 0;
-				for( const buffer& buf: bufs )
-				{
-					memcpy( &binding.second[ offset ],
-							buf.data( ),
-							std::min( chunkSize, totalSize - offset ) );
-					offset += chunkSize;
-				}
-			}
+	size_t size = 0;
+	for( ;; )
+	{
+		SQLRETURN rc = SQLGetData( *m_stmt,
+								   ( SQLUSMALLINT )field + 1,
+								   recordData.cDataType,
+								   ( SQLPOINTER )( buffer.data( ) + size ),
+								   buffer.size( ) - size,
+								   &indicator );
+		if( rc == SQL_NO_DATA )
+			break;
+		session_impl::check_stmt_error( rc, *m_stmt );
+
+		if( indicator == SQL_NULL_DATA )
+			break;
+
+		const size_t available = buffer.size( ) - size - terminator;
+		if( rc == SQL_SUCCESS || ( indicator != SQL_NO_TOTAL && ( size_t )indicator <= available ) )
+		{
+			size += indicator;
+			break;
 		}
+
+		// grow to the remaining length when the driver reports it
+		size += available;
+		buffer.resize( indicator == SQL_NO_TOTAL ? buffer.size( ) * 2
+												 : size + indicator - available + terminator );
 	}
+
+	recordData.state = long_state::fetched;
+	if( indicator == SQL_NULL_DATA )
+		size = 0;
+	else
+		indicator = size;
+
+	if( terminator )
+		buffer[ size ] = '\0';
 }
 
-inline void result_impl::get_record_data_timestamp( )
+template< typename F >
+inline bool result_impl::read_blob( size_t field, F&& callback )
 {
-	for( std::pair< size_t, timestamp_binding >& binding: m_tsBindings )
+	if( field >= m_fields.size( ) )
+		throw data_exception( "Invalid field index: " + std::to_string( field ) );
+
+	record_data& recordData = m_recordData[ field ];
+	if( recordData.bound || recordData.state != long_state::pending )
 	{
-		SQL_TIMESTAMP_STRUCT& ts = binding.second.ts;
-		binding.second.date = datetime(
-			date::sys_days( date::year( ts.year ) / ts.month / ts.day ) +
-			std::chrono::hours( ( int )ts.hour ) + std::chrono::minutes( ( int )ts.minute ) +
-			std::chrono::seconds( ( int )ts.second ) + std::chrono::microseconds( ts.fraction ) );
+		if( is_null( field ) )
+			return false;
+		const std::string_view value = get_string_view( field );
+		callback( value.data( ), value.size( ) );
+		return true;
 	}
+
+	fetch_long_data_before( field );
+	recordData.state = long_state::streamed;
+
+	// chunks go straight from the driver to the callback through the column buffer
+	std::vector< char >& buffer = long_data_buffer( recordData );
+	const size_t available = buffer.size( ) - ( recordData.cDataType == SQL_C_CHAR ? 1 : 0 );
+	SQLLEN& indicator = recordData.indicators[ 0 ];
+	for( ;; )
+	{
+		SQLRETURN rc = SQLGetData( *m_stmt,
+								   ( SQLUSMALLINT )field + 1,
+								   recordData.cDataType,
+								   ( SQLPOINTER )buffer.data( ),
+								   buffer.size( ),
+								   &indicator );
+		if( rc == SQL_NO_DATA )
+			break;
+		check_stmt_error( rc );
+
+		if( indicator == SQL_NULL_DATA )
+			return false;
+
+		const bool truncated = rc == SQL_SUCCESS_WITH_INFO &&
+							   ( indicator == SQL_NO_TOTAL || ( size_t )indicator > available );
+		callback( ( const char* )buffer.data( ), truncated ? available : ( size_t )indicator );
+		if( !truncated )
+			break;
+	}
+
+	return true;
 }
 
-template< typename binding_type >
 inline const result_impl::record_data& result_impl::data( size_t field,
-														  const binding_type& bindings ) const
+														  SQLSMALLINT cDataType ) const
 {
 	if( field >= m_fields.size( ) )
 		throw data_exception( "Invalid field index: " + std::to_string( field ) );
 
-	if( m_recordData[ field ].typedBindings != &bindings )
+	// bits are stored like tiny integers
+	const SQLSMALLINT fieldType = m_recordData[ field ].cDataType;
+	if( fieldType != cDataType && !( fieldType == SQL_C_BIT && cDataType == SQL_C_STINYINT ) )
 		throw data_exception( "Invalid field type for field: " + std::to_string( field ) );
 
-	if( m_recordData[ field ].ndxValue >= bindings.size( ) )
-		throw data_exception( "Out of bound field:" + std::to_string( field ) );
-
 	return m_recordData[ field ];
 }
 
+inline const char* result_impl::value( const record_data& recordData ) const
+{
+	return recordData.bound ? recordData.value + m_row * recordData.dataSize
+							: m_longData[ recordData.ndxData ].data( );
+}
+
+template< typename T >
+inline T result_impl::bound_value( size_t field, SQLSMALLINT cDataType ) const
+{
+	const record_data& recordData = data( field, cDataType );
+	return ( ( const T* )recordData.value )[ m_row ];
+}
+
 inline SQLSMALLINT result_impl::target_type( SQLSMALLINT sqlType ) const
 {
 	switch( sqlType )
@@ -412,83 +749,23 @@ inline SQLSMALLINT result_impl::target_type( SQLSMALLINT sqlType ) const
 	}
 }
 
-template< typename binding_type >
 inline void result_impl::set_typed_binding( const col_desc& cd,
 											bool bound,
 											SQLSMALLINT cDataType,
-											binding_type& bindings )
-{
-	bindings.emplace_back( );
-	m_recordData[ cd.pos - 1 ] = { true,      cDataType,           cd.columnSize, &bindings.back( ),
-								   &bindings, bindings.size( ) - 1 };
-}
-
-template<>
-inline void
-result_impl::set_typed_binding( const col_desc& cd,
-								bool bound,
-								SQLSMALLINT cDataType,
-								std::vector< std::pair< size_t, std::vector< char > > >& bindings )
+											SQLULEN dataSize )
 {
-	bindings.emplace_back( cd.pos - 1, bound ? cd.columnSize : 0 );
-	m_recordData[ cd.pos - 1 ] = {
-		bound,         cDataType,
-		cd.columnSize, bound ? &*bindings.back( ).second.begin( ) : nullptr,
-		&bindings,     bindings.size( ) - 1
-	};
-}
+	record_data& recordData = m_recordData[ cd.pos - 1 ];
+	recordData = { bound, cDataType, dataSize, nullptr, 0, nullptr, long_state::pending };
 
-template<>
-inline void
-result_impl::set_typed_binding( const col_desc& cd,
-								bool bound,
-								SQLSMALLINT cDataType,
-								std::vector< std::pair< size_t, timestamp_binding > >& bindings )
-{
-	bindings.emplace_back( cd.pos - 1, timestamp_binding( ) );
-	m_recordData[ cd.pos - 1 ] = { true,          cDataType,
-								   cd.columnSize, &bindings.back( ).second.ts,
-								   &bindings,     bindings.size( ) - 1 };
-}
-
-template< typename binding_type >
-inline void result_impl::grow_typed_binding( binding_type& bindings )
-{
-	bindings.reserve( bindings.capacity( ) + 1 );
-}
-
-inline void result_impl::grow_typed_binding( SQLSMALLINT dataType )
-{
-	switch( dataType )
+	if( !bound )
 	{
-	case SQL_CHAR:
-	case SQL_VARCHAR:
-	case SQL_LONGVARCHAR: grow_typed_binding( m_strBindings ); break;
-
-	case SQL_BIT:
-	case SQL_TINYINT: grow_typed_binding( m_int8Bindings ); break;
-
-	case SQL_SMALLINT: grow_typed_binding( m_int16Bindings ); break;
-
-	case SQL_INTEGER: grow_typed_binding( m_int32Bindings ); break;
-
-	case SQL_BIGINT: grow_typed_binding( m_int64Bindings ); break;
-
-	case SQL_REAL:
-	case SQL_DECIMAL:
-	case SQL_NUMERIC:
-	case SQL_FLOAT:
-	case SQL_DOUBLE: grow_typed_binding( m_dblBindings ); break;
-
-	case SQL_BINARY:
-	case SQL_VARBINARY:
-	case SQL_LONGVARBINARY: grow_typed_binding( m_binBindings ); break;
-
-	case SQL_TYPE_DATE:
-	case SQL_TYPE_TIME:
-	case SQL_TYPE_TIMESTAMP: grow_typed_binding( m_tsBindings ); break;
-
-	default: grow_typed_binding( m_strBindings );
+		recordData.ndxData = m_longData.size( );
+		m_longData.emplace_back( );
+	}
+	else if( cDataType == SQL_C_TYPE_TIMESTAMP )
+	{
+		recordData.ndxData = m_tsCache.size( );
+		m_tsCache.emplace_back( );
 	}
 }
 
@@ -499,42 +776,42 @@ inline void result_impl::init_typed_binding( col_desc& cd )
 	case SQL_CHAR:
 	case SQL_VARCHAR:
 		cd.columnSize++;
-		set_typed_binding( cd, true, SQL_C_CHAR, m_strBindings );
+		set_typed_binding( cd, true, SQL_C_CHAR, cd.columnSize );
 		break;
 
 	case SQL_LONGVARCHAR:
 		cd.columnSize++;
-		set_typed_binding( cd, false, SQL_C_CHAR, m_strBindings );
+		set_typed_binding( cd, false, SQL_C_CHAR, cd.columnSize );
 		break;
 
-	case SQL_BIT: set_typed_binding( cd, true, SQL_C_BIT, m_int8Bindings ); break;
+	case SQL_BIT: set_typed_binding( cd, true, SQL_C_BIT, sizeof( int8_t ) ); break;
 
-	case SQL_TINYINT: set_typed_binding( cd, true, SQL_C_STINYINT, m_int8Bindings ); break;
+	case SQL_TINYINT: set_typed_binding( cd, true, SQL_C_STINYINT, sizeof( int8_t ) ); break;
 
-	case SQL_SMALLINT: set_typed_binding( cd, true, SQL_C_SSHORT, m_int16Bindings ); break;
+	case SQL_SMALLINT: set_typed_binding( cd, true, SQL_C_SSHORT, sizeof( int16_t ) ); break;
 
-	case SQL_INTEGER: set_typed_binding( cd, true, SQL_C_SLONG, m_int32Bindings ); break;
+	case SQL_INTEGER: set_typed_binding( cd, true, SQL_C_SLONG, sizeof( int32_t ) ); break;
 
-	case SQL_BIGINT: set_typed_binding( cd, true, SQL_C_SBIGINT, m_int64Bindings ); break;
+	case SQL_BIGINT: set_typed_binding( cd, true, SQL_C_SBIGINT, sizeof( int64_t ) ); break;
 
 	case SQL_REAL:
 	case SQL_DECIMAL:
 	case SQL_NUMERIC:
 	case SQL_FLOAT:
-	case SQL_DOUBLE: set_typed_binding( cd, true, SQL_C_DOUBLE, m_dblBindings ); break;
+	case SQL_DOUBLE: set_typed_binding( cd, true, SQL_C_DOUBLE, sizeof( double ) ); break;
 
 	case SQL_BINARY:
-	case SQL_VARBINARY: set_typed_binding( cd, true, SQL_C_BINARY, m_binBindings ); break;
+	case SQL_VARBINARY: set_typed_binding( cd, true, SQL_C_BINARY, cd.columnSize ); break;
 
-	case SQL_LONGVARBINARY: set_typed_binding( cd, false, SQL_C_BINARY, m_binBindings ); break;
+	case SQL_LONGVARBINARY: set_typed_binding( cd, false, SQL_C_BINARY, cd.columnSize ); break;
 
 	case SQL_TYPE_DATE:
 	case SQL_TYPE_TIME:
 	case SQL_TYPE_TIMESTAMP:
-		set_typed_binding( cd, true, SQL_C_TYPE_TIMESTAMP, m_tsBindings );
+		set_typed_binding( cd, true, SQL_C_TYPE_TIMESTAMP, sizeof( SQL_TIMESTAMP_STRUCT ) );
 		break;
 
-	default: set_typed_binding( cd, true, SQL_C_CHAR, m_strBindings );
+	default: set_typed_binding( cd, true, SQL_C_CHAR, cd.columnSize );
 	}
 }
 
@@ -574,5 +851,29 @@ inline field::type result_impl::map_db_type( SQLSMALLINT dataType )
 	}
 }
 
+inline size_t result_impl::binding_size( const col_desc& cd )
+{
+	// mirrors init_typed_binding, the other types are bound as text of the column size
+	switch( cd.dataType )
+	{
+	case SQL_LONGVARCHAR:
+	case SQL_LONGVARBINARY: return 0;
+	case SQL_BIT:
+	case SQL_TINYINT: return sizeof( int8_t );
+	case SQL_SMALLINT: return sizeof( int16_t );
+	case SQL_INTEGER: return sizeof( int32_t );
+	case SQL_BIGINT: return sizeof( int64_t );
+	case SQL_REAL:
+	case SQL_DECIMAL:
+	case SQL_NUMERIC:
+	case SQL_FLOAT:
+	case SQL_DOUBLE: return sizeof( double );
+	case SQL_TYPE_DATE:
+	case SQL_TYPE_TIME:
+	case SQL_TYPE_TIMESTAMP: return sizeof( SQL_TIMESTAMP_STRUCT );
+	default: return cd.columnSize + 1;
+	}
+}
+
 }  // namespace odbc
 }  // namespace dbclt
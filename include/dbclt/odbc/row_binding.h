@@ -0,0 +1,129 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <structs/to_tuple.h>
+
+namespace dbclt
+{
+namespace odbc
+{
+// storage and c type used to fetch a struct member in place, specialized per member type
+template< typename T >
+struct row_field
+{
+	static constexpr bool supported = false;
+};
+
+// true when T is an aggregate made only of members with a row_field specialization
+template< typename T >
+constexpr bool is_row_bindable( );
+
+// row-wise binding of a result into an array of staging rows laid out from the members of T
+template< typename T >
+class row_binding
+{
+public:
+	// stringSizes holds the buffer width, terminator included, of each string column
+	row_binding( const std::vector< SQLULEN >& stringSizes, size_t rows );
+
+	size_t stride( ) const;
+	size_t rows( ) const;
+
+	void bind( HSTMT stmt );
+	T get( size_t row ) const;
+
+private:
+	using tuple_type = decltype( structs::to_tuple( std::declval< T& >( ) ) );
+
+	template< std::size_t I >
+	using field_type = row_field< std::decay_t< std::tuple_element_t< I, tuple_type > > >;
+
+	template< std::size_t... I >
+	void layout( const std::vector< SQLULEN >& stringSizes, std::index_sequence< I... > );
+
+	template< std::size_t... I >
+	void bind( HSTMT stmt, std::index_sequence< I... > );
+
+	template< std::size_t... I >
+	T get( const char* row, std::index_sequence< I... > ) const;
+
+private:
+	struct column
+	{
+		size_t valueOffset;
+		size_t indicatorOffset;
+		SQLLEN size;
+	};
+
+	std::vector< column > m_columns;
+	std::vector< char > m_buffer;
+	size_t m_stride { 0 };
+	size_t m_rows { 0 };
+};
+
+// column-wise parameter arrays filled from the members of T, one array element per row
+template< typename T >
+class param_binding
+{
+public:
+	template< typename It >
+	void fill( It first, It last );
+
+	size_t rows( ) const;
+	void bind( HSTMT stmt );
+
+private:
+	using tuple_type = decltype( structs::to_tuple( std::declval< T& >( ) ) );
+
+	template< std::size_t I >
+	using field_type = row_field< std::decay_t< std::tuple_element_t< I, tuple_type > > >;
+
+	template< std::size_t... I >
+	void fill( const std::vector< tuple_type >& values, std::index_sequence< I... > );
+
+	template< std::size_t I >
+	void fill_column( const std::vector< tuple_type >& values );
+
+	template< std::size_t... I >
+	void bind( HSTMT stmt, std::index_sequence< I... > );
+
+	template< std::size_t I >
+	void bind_column( HSTMT stmt );
+
+private:
+	struct column
+	{
+		std::vector< char > values;
+		std::vector< SQLLEN > indicators;
+		size_t width;
+	};
+
+	std::vector< column > m_columns;
+	size_t m_rows { 0 };
+};
+
+}  // namespace odbc
+}  // namespace dbclt
@@ -0,0 +1,422 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+namespace dbclt
+{
+namespace odbc
+{
+template< typename T, SQLSMALLINT CType, SQLSMALLINT SqlType, SQLULEN ColumnSize >
+struct fixed_row_field
+{
+	static constexpr bool supported = true;
+	static constexpr bool variable = false;
+	static constexpr SQLSMALLINT c_type = CType;
+	static constexpr SQLSMALLINT sql_type = SqlType;
+	static constexpr SQLULEN column_size = ColumnSize;
+	static constexpr SQLSMALLINT decimal_digits = 0;
+	using storage_type = T;
+
+	static T get( const char* value, SQLLEN indicator )
+	{
+		return indicator == SQL_NULL_DATA ? T( ) : *( const T* )value;
+	}
+
+	static SQLLEN put( const T& v, char* value )
+	{
+		*( T* )value = v;
+		return sizeof( T );
+	}
+};
+
+template<>
+struct row_field< int8_t > : fixed_row_field< int8_t, SQL_C_STINYINT, SQL_TINYINT, 3 >
+{
+};
+
+template<>
+struct row_field< uint8_t > : fixed_row_field< uint8_t, SQL_C_UTINYINT, SQL_TINYINT, 3 >
+{
+};
+
+template<>
+struct row_field< int16_t > : fixed_row_field< int16_t, SQL_C_SSHORT, SQL_SMALLINT, 5 >
+{
+};
+
+template<>
+struct row_field< uint16_t > : fixed_row_field< uint16_t, SQL_C_USHORT, SQL_SMALLINT, 5 >
+{
+};
+
+template<>
+struct row_field< int32_t > : fixed_row_field< int32_t, SQL_C_SLONG, SQL_INTEGER, 10 >
+{
+};
+
+template<>
+struct row_field< uint32_t > : fixed_row_field< uint32_t, SQL_C_ULONG, SQL_INTEGER, 10 >
+{
+};
+
+template<>
+struct row_field< int64_t > : fixed_row_field< int64_t, SQL_C_SBIGINT, SQL_BIGINT, 19 >
+{
+};
+
+template<>
+struct row_field< uint64_t > : fixed_row_field< uint64_t, SQL_C_UBIGINT, SQL_BIGINT, 20 >
+{
+};
+
+template<>
+struct row_field< float > : fixed_row_field< float, SQL_C_FLOAT, SQL_REAL, 7 >
+{
+};
+
+template<>
+struct row_field< double > : fixed_row_field< double, SQL_C_DOUBLE, SQL_DOUBLE, 15 >
+{
+};
+
+template<>
+struct row_field< bool >
+{
+	static constexpr bool supported = true;
+	static constexpr bool variable = false;
+	static constexpr SQLSMALLINT c_type = SQL_C_BIT;
+	static constexpr SQLSMALLINT sql_type = SQL_BIT;
+	static constexpr SQLULEN column_size = 1;
+	static constexpr SQLSMALLINT decimal_digits = 0;
+	using storage_type = unsigned char;
+
+	static bool get( const char* value, SQLLEN indicator )
+	{
+		return indicator != SQL_NULL_DATA && *value != 0;
+	}
+
+	static SQLLEN put( bool v, char* value )
+	{
+		*value = v ? 1 : 0;
+		return sizeof( storage_type );
+	}
+};
+
+template<>
+struct row_field< datetime >
+{
+	static constexpr bool supported = true;
+	static constexpr bool variable = false;
+	static constexpr SQLSMALLINT c_type = SQL_C_TYPE_TIMESTAMP;
+	static constexpr SQLSMALLINT sql_type = SQL_TYPE_TIMESTAMP;
+	static constexpr SQLULEN column_size = 26;
+	static constexpr SQLSMALLINT decimal_digits = 6;
+	using storage_type = SQL_TIMESTAMP_STRUCT;
+
+	static datetime get( const char* value, SQLLEN indicator )
+	{
+		return indicator == SQL_NULL_DATA ? datetime( )
+										  : to_datetime( *( const SQL_TIMESTAMP_STRUCT* )value );
+	}
+
+	static SQLLEN put( const datetime& v, char* value )
+	{
+		*( SQL_TIMESTAMP_STRUCT* )value = to_timestamp( v );
+		return sizeof( storage_type );
+	}
+};
+
+// strings are stored null terminated in a buffer sized from the column, or from the
+// longest value when sent as parameters
+template<>
+struct row_field< std::string >
+{
+	static constexpr bool supported = true;
+	static constexpr bool variable = true;
+	static constexpr SQLSMALLINT c_type = SQL_C_CHAR;
+	static constexpr SQLSMALLINT sql_type = SQL_VARCHAR;
+	static constexpr SQLSMALLINT decimal_digits = 0;
+	using storage_type = char;
+
+	static std::string get( const char* value, SQLLEN indicator )
+	{
+		return indicator == SQL_NULL_DATA ? std::string( ) : std::string( value );
+	}
+
+	static size_t size( const std::string& v )
+	{
+		return v.length( ) + 1;
+	}
+
+	static SQLLEN put( const std::string& v, char* value )
+	{
+		memcpy( value, v.c_str( ), v.length( ) + 1 );
+		return ( SQLLEN )v.length( );
+	}
+};
+
+template< typename T >
+struct row_field< std::optional< T > > : row_field< T >
+{
+	static std::optional< T > get( const char* value, SQLLEN indicator )
+	{
+		if( indicator == SQL_NULL_DATA )
+			return std::optional< T >( );
+		return row_field< T >::get( value, indicator );
+	}
+
+	static size_t size( const std::optional< T >& v )
+	{
+		return v ? row_field< T >::size( *v ) : 1;
+	}
+
+	static SQLLEN put( const std::optional< T >& v, char* value )
+	{
+		return v ? row_field< T >::put( *v, value ) : SQL_NULL_DATA;
+	}
+};
+
+template< typename Tup, std::size_t... I >
+constexpr bool row_fields_supported( std::index_sequence< I... > )
+{
+	return ( row_field< std::decay_t< std::tuple_element_t< I, Tup > > >::supported && ... );
+}
+
+template< typename T >
+constexpr bool is_row_bindable( )
+{
+	if constexpr( std::is_aggregate_v< T > )
+	{
+		using Tup = decltype( structs::to_tuple( std::declval< T& >( ) ) );
+		if constexpr( std::tuple_size_v< Tup > > 0 )
+			return row_fields_supported< Tup >(
+				std::make_index_sequence< std::tuple_size_v< Tup > > { } );
+		else
+			return false;
+	}
+	else
+		return false;
+}
+
+template< typename T >
+inline row_binding< T >::row_binding( const std::vector< SQLULEN >& stringSizes, size_t rows )
+	: m_rows( std::max< size_t >( rows, 1 ) )
+{
+	layout( stringSizes, std::make_index_sequence< std::tuple_size_v< tuple_type > > { } );
+	m_buffer.resize( m_stride * m_rows );
+}
+
+template< typename T >
+inline size_t row_binding< T >::stride( ) const
+{
+	return m_stride;
+}
+
+template< typename T >
+inline size_t row_binding< T >::rows( ) const
+{
+	return m_rows;
+}
+
+template< typename T >
+template< std::size_t... I >
+inline void row_binding< T >::layout( const std::vector< SQLULEN >& stringSizes,
+									  std::index_sequence< I... > )
+{
+	auto align = []( size_t offset, size_t alignment ) {
+		return ( offset + alignment - 1 ) / alignment * alignment;
+	};
+
+	// fixed size values and indicators first, then the variable sized strings
+	const size_t sizes[] = { sizeof( typename field_type< I >::storage_type )... };
+	const size_t alignments[] = { alignof( typename field_type< I >::storage_type )... };
+	const bool variable[] = { field_type< I >::variable... };
+
+	size_t offset = 0;
+	m_columns.resize( sizeof...( I ) );
+	for( size_t i = 0; i < sizeof...( I ); ++i )
+	{
+		column& col = m_columns[ i ];
+		col.indicatorOffset = offset = align( offset, alignof( SQLLEN ) );
+		offset += sizeof( SQLLEN );
+		if( !variable[ i ] )
+		{
+			col.valueOffset = offset = align( offset, alignments[ i ] );
+			col.size = sizes[ i ];
+			offset += sizes[ i ];
+		}
+	}
+
+	for( size_t i = 0; i < sizeof...( I ); ++i )
+		if( variable[ i ] )
+		{
+			column& col = m_columns[ i ];
+			col.valueOffset = offset;
+			col.size = i < stringSizes.size( ) && stringSizes[ i ] > 0 ? stringSizes[ i ] : 64;
+			offset += col.size;
+		}
+
+	// consecutive rows keep every member aligned
+	size_t rowAlignment = alignof( SQLLEN );
+	for( size_t alignment: alignments )
+		rowAlignment = std::max( rowAlignment, alignment );
+	m_stride = align( offset, rowAlignment );
+}
+
+template< typename T >
+inline void row_binding< T >::bind( HSTMT stmt )
+{
+	session_impl::check_stmt_error(
+		SQLSetStmtAttr( stmt, SQL_ATTR_ROW_BIND_TYPE, ( SQLPOINTER )m_stride, 0 ), stmt );
+	session_impl::check_stmt_error(
+		SQLSetStmtAttr( stmt, SQL_ATTR_ROW_ARRAY_SIZE, ( SQLPOINTER )m_rows, 0 ), stmt );
+	bind( stmt, std::make_index_sequence< std::tuple_size_v< tuple_type > > { } );
+}
+
+template< typename T >
+template< std::size_t... I >
+inline void row_binding< T >::bind( HSTMT stmt, std::index_sequence< I... > )
+{
+	const SQLSMALLINT types[] = { field_type< I >::c_type... };
+	for( size_t i = 0; i < sizeof...( I ); ++i )
+	{
+		const column& col = m_columns[ i ];
+		session_impl::check_stmt_error( SQLBindCol( stmt,
+													( SQLUSMALLINT )i + 1,
+													types[ i ],
+													m_buffer.data( ) + col.valueOffset,
+													col.size,
+													( SQLLEN* )( m_buffer.data( ) +
+																 col.indicatorOffset ) ),
+										stmt );
+	}
+}
+
+template< typename T >
+inline T row_binding< T >::get( size_t row ) const
+{
+	return get( m_buffer.data( ) + row * m_stride,
+				std::make_index_sequence< std::tuple_size_v< tuple_type > > { } );
+}
+
+template< typename T >
+template< std::size_t... I >
+inline T row_binding< T >::get( const char* row, std::index_sequence< I... > ) const
+{
+	return T { field_type< I >::get(
+		row + m_columns[ I ].valueOffset,
+		*( const SQLLEN* )( row + m_columns[ I ].indicatorOffset ) )... };
+}
+
+template< typename T >
+template< typename It >
+inline void param_binding< T >::fill( It first, It last )
+{
+	std::vector< tuple_type > values;
+	for( ; first != last; ++first )
+		values.emplace_back( structs::to_tuple( *first ) );
+
+	m_rows = values.size( );
+	fill( values, std::make_index_sequence< std::tuple_size_v< tuple_type > > { } );
+}
+
+template< typename T >
+template< std::size_t... I >
+inline void param_binding< T >::fill( const std::vector< tuple_type >& values,
+									  std::index_sequence< I... > )
+{
+	m_columns.resize( sizeof...( I ) );
+	( fill_column< I >( values ), ... );
+}
+
+template< typename T >
+template< std::size_t I >
+inline void param_binding< T >::fill_column( const std::vector< tuple_type >& values )
+{
+	using field = field_type< I >;
+
+	// variable sized members are laid out with the width of the longest value
+	column& col = m_columns[ I ];
+	col.width = sizeof( typename field::storage_type );
+	if constexpr( field::variable )
+		for( const tuple_type& value: values )
+			col.width = std::max( col.width, field::size( std::get< I >( value ) ) );
+
+	col.values.resize( col.width * values.size( ) );
+	col.indicators.resize( values.size( ) );
+	for( size_t r = 0; r < values.size( ); ++r )
+		col.indicators[ r ] =
+			field::put( std::get< I >( values[ r ] ), col.values.data( ) + r * col.width );
+}
+
+template< typename T >
+inline size_t param_binding< T >::rows( ) const
+{
+	return m_rows;
+}
+
+template< typename T >
+inline void param_binding< T >::bind( HSTMT stmt )
+{
+	session_impl::check_stmt_error(
+		SQLSetStmtAttr( stmt, SQL_ATTR_PARAMSET_SIZE, ( SQLPOINTER )m_rows, 0 ), stmt );
+	bind( stmt, std::make_index_sequence< std::tuple_size_v< tuple_type > > { } );
+}
+
+template< typename T >
+template< std::size_t... I >
+inline void param_binding< T >::bind( HSTMT stmt, std::index_sequence< I... > )
+{
+	( bind_column< I >( stmt ), ... );
+}
+
+template< typename T >
+template< std::size_t I >
+inline void param_binding< T >::bind_column( HSTMT stmt )
+{
+	using field = field_type< I >;
+
+	column& col = m_columns[ I ];
+	SQLULEN columnSize;
+	if constexpr( field::variable )
+		columnSize = std::max< size_t >( col.width - 1, 1 );
+	else
+		columnSize = field::column_size;
+
+	session_impl::check_stmt_error( SQLBindParameter( stmt,
+													  ( SQLUSMALLINT )I + 1,
+													  SQL_PARAM_INPUT,
+													  field::c_type,
+													  field::sql_type,
+													  columnSize,
+													  field::decimal_digits,
+													  col.values.data( ),
+													  col.width,
+													  col.indicators.data( ) ),
+									stmt );
+}
+
+}  // namespace odbc
+}  // namespace dbclt
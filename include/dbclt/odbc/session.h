@@ -63,11 +63,39 @@ public:
 	result_type execute( const std::string& stmt );
 	recordset_type query( const std::string& stmt );
 
+	// the session must not be used until the returned future is ready
+	std::future< result_type > async_execute(
+		const std::string& stmt, async_scheduler& scheduler = async_scheduler::instance( ) );
+	std::future< recordset_type > async_query(
+		const std::string& stmt, async_scheduler& scheduler = async_scheduler::instance( ) );
+
+	template< typename T >
+	void bulk_insert( const std::string& table, const T& container );
+
+	// the environment used by the next connect, the process wide one by default. once a pooled
+	// environment is requested, pooling stays enabled for environments allocated later as well
+	void set_environment( env_ptr env );
+	static env_ptr shared_environment( bool pooled = false );
+
+	void set_row_array_size( size_t rows );
+	size_t row_array_size( ) const;
+	void set_param_array_size( size_t rows );
+	size_t param_array_size( ) const;
+
 	static std::string get_messages( SQLHANDLE h, SQLSMALLINT handleType );
 
 private:
+	statement_ptr prepare( const std::string& stmt );
+	result_impl::column_cache_ptr cached_columns( const std::string& stmt,
+												  const statement_ptr& handle );
+	static bool changes_schema( const std::string& stmt );
+
+	template< typename T, typename F >
+	std::future< T >
+	async_direct( const std::string& stmt, async_scheduler& scheduler, F complete );
+
 	template< typename HANDLE >
-	void alloc_handle( HANDLE& handle, SQLSMALLINT handleType, SQLHANDLE input );
+	static void alloc_handle( HANDLE& handle, SQLSMALLINT handleType, SQLHANDLE input );
 
 	static void check_error( SQLRETURN rc, SQLHANDLE h, SQLSMALLINT handleType );
 	static void check_dbc_error( SQLRETURN rc, HDBC dbc );
@@ -80,9 +108,24 @@ private:
 	conn_ptr m_dbc;
 	bool m_transaction { false };
 	std::string m_connectionString;
+	size_t m_rowArraySize { 256 };
+	size_t m_paramArraySize { 4096 };
+
+	// prepared handles by statement text, reused once no result holds them anymore
+	std::map< std::string, statement_ptr > m_prepared;
+
+	// column layouts by statement text, dropped after a statement that may change the schema
+	// or the search path, checked against the column types when reused
+	std::map< std::string, result_impl::column_cache_ptr > m_columns;
 
 	friend result_impl;
 	friend statement_impl;
+	friend class connection_pool;
+
+	template< typename T >
+	friend class row_binding;
+	template< typename T >
+	friend class param_binding;
 };
 
 using session = dbclt::session< session_impl >;
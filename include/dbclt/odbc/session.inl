@@ -165,12 +165,11 @@ inline bool session_impl::connected( ) const
 
 inline void session_impl::connect( const std::string& connInfo )
 {
+	if( !m_env )
+		m_env = shared_environment( );
+
 	try
 	{
-		alloc_handle( m_env, SQL_HANDLE_ENV, SQL_NULL_HANDLE );
-		check_env_error(
-			SQLSetEnvAttr( *m_env, SQL_ATTR_ODBC_VERSION, ( SQLPOINTER* )SQL_OV_ODBC3, 0 ) );
-
 		alloc_handle( m_dbc, SQL_HANDLE_DBC, *m_env );
 		check_dbc_error( SQLSetConnectAttr( *m_dbc, SQL_LOGIN_TIMEOUT, ( SQLPOINTER )5, 0 ) );
 		check_dbc_error( SQLSetConnectAttr( *m_dbc, SQL_ATTR_AUTOCOMMIT, ( SQLPOINTER ) true, 0 ) );
@@ -189,12 +188,52 @@ inline void session_impl::connect( const std::string& connInfo )
 	}
 	catch( const std::exception& )
 	{
-		m_env.reset( );
 		m_dbc.reset( );
 		throw;
 	}
 }
 
+inline void session_impl::set_environment( env_ptr env )
+{
+	m_env = env;
+}
+
+inline env_ptr session_impl::shared_environment( bool pooled )
+{
+	// one environment per kind for the whole process, released with its last session
+	static std::mutex mutex;
+	static std::weak_ptr< env_ptr::element_type > environments[ 2 ];
+
+	std::lock_guard< std::mutex > lock( mutex );
+	env_ptr env = environments[ pooled ].lock( );
+	if( env )
+		return env;
+
+	// pooling is process wide and picked up by every environment allocated after it is enabled,
+	// so it is switched on once and left on rather than racing other code allocating environments
+	static bool poolingEnabled = false;
+	if( pooled && !poolingEnabled )
+	{
+		const auto rc = SQLSetEnvAttr(
+			SQL_NULL_HANDLE, SQL_ATTR_CONNECTION_POOLING, ( SQLPOINTER )SQL_CP_ONE_PER_HENV, 0 );
+		if( !SQL_SUCCEEDED( rc ) )
+			throw data_exception( "Cannot enable ODBC connection pooling" );
+		poolingEnabled = true;
+	}
+
+	alloc_handle( env, SQL_HANDLE_ENV, SQL_NULL_HANDLE );
+	if( pooled )
+		check_error( SQLSetEnvAttr( *env, SQL_ATTR_CP_MATCH, ( SQLPOINTER )SQL_CP_STRICT_MATCH, 0 ),
+					 *env,
+					 SQL_HANDLE_ENV );
+	check_error( SQLSetEnvAttr( *env, SQL_ATTR_ODBC_VERSION, ( SQLPOINTER* )SQL_OV_ODBC3, 0 ),
+				 *env,
+				 SQL_HANDLE_ENV );
+
+	environments[ pooled ] = env;
+	return env;
+}
+
 inline const std::string& session_impl::connectionString( ) const
 {
 	return m_connectionString;
@@ -204,9 +243,110 @@ inline void session_impl::disconnect( )
 {
 	if( m_dbc && *m_dbc != SQL_NULL_HANDLE )
 	{
+		m_prepared.clear( );
+		m_columns.clear( );
 		check_dbc_error( SQLDisconnect( *m_dbc ) );
 		m_dbc.reset( );
-		m_env.reset( );
+	}
+}
+
+inline void session_impl::set_row_array_size( size_t rows )
+{
+	m_rowArraySize = std::max< size_t >( rows, 1 );
+}
+
+inline size_t session_impl::row_array_size( ) const
+{
+	return m_rowArraySize;
+}
+
+inline void session_impl::set_param_array_size( size_t rows )
+{
+	m_paramArraySize = std::max< size_t >( rows, 1 );
+}
+
+inline size_t session_impl::param_array_size( ) const
+{
+	return m_paramArraySize;
+}
+
+template< typename T >
+inline void session_impl::bulk_insert( const std::string& table, const T& container )
+{
+	using row_type = typename T::value_type;
+	using Tup = decltype( structs::to_tuple( std::declval< row_type& >( ) ) );
+	static_assert( is_row_bindable< row_type >( ), "Unsupported row type for bulk insert" );
+
+	if( !connected( ) )
+		throw data_exception( "Connection is not opened" );
+
+	std::string stmtText = "insert into " + table + " values (";
+	for( size_t i = 0; i < std::tuple_size_v< Tup >; ++i )
+		stmtText += i == 0 ? "?" : ",?";
+	stmtText += ")";
+
+	statement_ptr stmt;
+	alloc_handle( stmt, SQL_HANDLE_STMT, *m_dbc );
+	check_stmt_error( SQLPrepare( *stmt, ( SQLCHAR* )stmtText.c_str( ), SQL_NTS ), *stmt );
+
+	// keep the parameter arrays within a few megabytes and to what the driver accepts
+	constexpr size_t maxChunkSize = 4 * 1024 * 1024;
+	size_t chunkSize =
+		std::clamp< size_t >( maxChunkSize / sizeof( row_type ), 1, m_paramArraySize );
+	if( !SQL_SUCCEEDED(
+			SQLSetStmtAttr( *stmt, SQL_ATTR_PARAMSET_SIZE, ( SQLPOINTER )chunkSize, 0 ) ) )
+		chunkSize = 1;
+
+	SQLULEN paramsetSize = chunkSize;
+	if( SQL_SUCCEEDED( SQLGetStmtAttr(
+			*stmt, SQL_ATTR_PARAMSET_SIZE, &paramsetSize, sizeof( paramsetSize ), nullptr ) ) &&
+		paramsetSize > 0 )
+		chunkSize = std::min< size_t >( paramsetSize, chunkSize );
+
+	std::vector< SQLUSMALLINT > status( chunkSize, SQL_PARAM_UNUSED );
+	SQLULEN processed = 0;
+	check_stmt_error( SQLSetStmtAttr( *stmt, SQL_ATTR_PARAM_STATUS_PTR, status.data( ), 0 ),
+					  *stmt );
+	check_stmt_error( SQLSetStmtAttr( *stmt, SQL_ATTR_PARAMS_PROCESSED_PTR, &processed, 0 ),
+					  *stmt );
+
+	// all chunks are committed together unless the caller already runs a transaction
+	const bool ownTransaction = !m_transaction;
+	if( ownTransaction )
+		begin_transaction( );
+
+	try
+	{
+		param_binding< row_type > binding;
+		size_t offset = 0;
+		for( auto first = std::begin( container ); first != std::end( container ); )
+		{
+			auto last = first;
+			for( size_t n = 0; n < chunkSize && last != std::end( container ); ++n )
+				++last;
+
+			binding.fill( first, last );
+			binding.bind( *stmt );
+			processed = 0;
+			check_stmt_error( SQLExecute( *stmt ), *stmt );
+
+			for( size_t r = 0; r < processed; ++r )
+				if( status[ r ] == SQL_PARAM_ERROR )
+					throw data_exception( "Cannot insert row: " + std::to_string( offset + r ) +
+										  " -- " + get_messages( *stmt, SQL_HANDLE_STMT ) );
+
+			offset += binding.rows( );
+			first = last;
+		}
+
+		if( ownTransaction )
+			commit_transaction( );
+	}
+	catch( ... )
+	{
+		if( ownTransaction )
+			rollback_transaction( );
+		throw;
 	}
 }
 
@@ -219,7 +359,8 @@ inline session_impl::result_type session_impl::execute( const std::string& stmtT
 	alloc_handle( stmt, SQL_HANDLE_STMT, *m_dbc );
 	check_stmt_error( SQLExecDirect( *stmt, ( SQLCHAR* )stmtText.c_str( ), SQL_NTS ), *stmt );
 
-	return result_type( result_impl::create( stmt ) );
+	return result_type(
+		result_impl::create( stmt, m_rowArraySize, cached_columns( stmtText, stmt ) ) );
 }
 
 inline session_impl::recordset_type session_impl::query( const std::string& stmtText )
@@ -231,9 +372,139 @@ inline session_impl::recordset_type session_impl::query( const std::string& stmt
 	alloc_handle( stmt, SQL_HANDLE_STMT, *m_dbc );
 	check_stmt_error( SQLExecDirect( *stmt, ( SQLCHAR* )stmtText.c_str( ), SQL_NTS ), *stmt );
 
-	result_type result( result_impl::create( stmt ) );
+	result_type result(
+		result_impl::create( stmt, m_rowArraySize, cached_columns( stmtText, stmt ) ) );
 	return *result.recordsets( ).begin( );
 }
 
+inline std::future< session_impl::result_type >
+session_impl::async_execute( const std::string& stmtText, async_scheduler& scheduler )
+{
+	return async_direct< result_type >(
+		stmtText, scheduler, [ rowArraySize = m_rowArraySize ]( const statement_ptr& stmt ) {
+			return result_type( result_impl::create( stmt, rowArraySize ) );
+		} );
+}
+
+inline std::future< session_impl::recordset_type >
+session_impl::async_query( const std::string& stmtText, async_scheduler& scheduler )
+{
+	return async_direct< recordset_type >(
+		stmtText, scheduler, [ rowArraySize = m_rowArraySize ]( const statement_ptr& stmt ) {
+			result_type result( result_impl::create( stmt, rowArraySize ) );
+			return *result.recordsets( ).begin( );
+		} );
+}
+
+template< typename T, typename F >
+inline std::future< T >
+session_impl::async_direct( const std::string& stmtText, async_scheduler& scheduler, F complete )
+{
+	if( !connected( ) )
+		throw data_exception( "Connection is not opened" );
+
+	statement_ptr stmt;
+	alloc_handle( stmt, SQL_HANDLE_STMT, *m_dbc );
+
+	// drivers without asynchronous statements complete in a single blocking poll
+	const bool async = SQL_SUCCEEDED( SQLSetStmtAttr(
+		*stmt, SQL_ATTR_ASYNC_ENABLE, ( SQLPOINTER )SQL_ASYNC_ENABLE_ON, 0 ) );
+
+	auto promise = std::make_shared< std::promise< T > >( );
+	std::future< T > future = promise->get_future( );
+
+	// the operation keeps the connection alive until the statement completes
+	scheduler.post( [ promise, stmt, dbc = m_dbc, stmtText, async, complete ]( ) {
+		try
+		{
+			const SQLRETURN rc = SQLExecDirect( *stmt, ( SQLCHAR* )stmtText.c_str( ), SQL_NTS );
+			if( rc == SQL_STILL_EXECUTING )
+				return false;
+
+			// results are fetched synchronously
+			if( async )
+				SQLSetStmtAttr(
+					*stmt, SQL_ATTR_ASYNC_ENABLE, ( SQLPOINTER )SQL_ASYNC_ENABLE_OFF, 0 );
+			check_stmt_error( rc, *stmt );
+
+			promise->set_value( complete( stmt ) );
+		}
+		catch( ... )
+		{
+			promise->set_exception( std::current_exception( ) );
+		}
+		return true;
+	} );
+
+	return future;
+}
+
+inline result_impl::column_cache_ptr
+session_impl::cached_columns( const std::string& stmtText, const statement_ptr& stmt )
+{
+	constexpr size_t maxCached = 64;
+
+	SQLSMALLINT fields = 0;
+	check_stmt_error( SQLNumResultCols( *stmt, &fields ), *stmt );
+	if( fields == 0 )
+	{
+		if( changes_schema( stmtText ) )
+			m_columns.clear( );
+		return nullptr;
+	}
+
+	auto it = m_columns.find( stmtText );
+	if( it == m_columns.end( ) )
+	{
+		if( m_columns.size( ) >= maxCached )
+			m_columns.clear( );
+		it = m_columns
+				 .emplace( stmtText, std::make_shared< result_impl::column_cache >( ) )
+				 .first;
+	}
+	return it->second;
+}
+
+inline bool session_impl::changes_schema( const std::string& stmtText )
+{
+	// ddl, or a set/use switching the search path or the database the names resolve in
+	std::string word;
+	for( char c: stmtText )
+	{
+		if( isalpha( ( unsigned char )c ) )
+			word += ( char )tolower( ( unsigned char )c );
+		else if( !word.empty( ) || !isspace( ( unsigned char )c ) )
+			break;
+	}
+	return word == "create" || word == "alter" || word == "drop" || word == "truncate" ||
+		   word == "set" || word == "use";
+}
+
+inline statement_ptr session_impl::prepare( const std::string& stmtText )
+{
+	if( !connected( ) )
+		throw data_exception( "Connection is not opened" );
+
+	constexpr size_t maxPrepared = 64;
+
+	auto it = m_prepared.find( stmtText );
+	if( it != m_prepared.end( ) && it->second.use_count( ) == 1 )
+	{
+		statement_ptr& stmt = it->second;
+		check_stmt_error( SQLFreeStmt( *stmt, SQL_CLOSE ), *stmt );
+		check_stmt_error( SQLFreeStmt( *stmt, SQL_RESET_PARAMS ), *stmt );
+		return stmt;
+	}
+
+	// a handle still used by a result gets a one-off companion
+	statement_ptr stmt;
+	alloc_handle( stmt, SQL_HANDLE_STMT, *m_dbc );
+	check_stmt_error( SQLPrepare( *stmt, ( SQLCHAR* )stmtText.c_str( ), SQL_NTS ), *stmt );
+	if( it == m_prepared.end( ) && m_prepared.size( ) < maxPrepared )
+		m_prepared.emplace( stmtText, stmt );
+
+	return stmt;
+}
+
 }  // namespace odbc
 }  // namespace dbclt
@@ -47,11 +47,42 @@ public:
 	statement_impl( session_impl& session );
 
 	result_type execute( const std::string& stmt );
+	result_type execute_params( const std::string& stmt );
 	recordset_type query( const std::string& stmt );
+	recordset_type query_params( const std::string& stmt );
+
+	template< typename T1, typename T2 >
+	void bind_parameter( const T1& value, T2& bound );
+
+	template< typename T >
+	auto get_binder_traits( const T& )
+	{
+		return binder_traits< T >( );
+	}
+
+private:
+	struct parameter
+	{
+		SQLSMALLINT cType;
+		SQLSMALLINT sqlType;
+		SQLULEN columnSize;
+		SQLSMALLINT decimalDigits;
+		SQLPOINTER value;
+		SQLLEN bufferLength;
+		SQLLEN indicator;
+	};
+
+	statement_ptr execute_prepared( const std::string& stmt );
+	void add_parameter( SQLSMALLINT cType,
+						SQLSMALLINT sqlType,
+						SQLULEN columnSize,
+						SQLSMALLINT decimalDigits,
+						const void* value,
+						SQLLEN length );
 
 private:
 	session_impl& m_session;
-	statement_ptr m_stmt;
+	std::vector< parameter > m_params;
 };
 
 using statement = dbclt::statement< statement_impl >;
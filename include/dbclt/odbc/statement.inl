@@ -44,10 +44,155 @@ inline statement_impl::result_type statement_impl::execute( const std::string& s
 	return m_session.execute( stmtText );
 }
 
+inline statement_impl::result_type statement_impl::execute_params( const std::string& stmtText )
+{
+	statement_ptr stmt = execute_prepared( stmtText );
+	return result_type( result_impl::create(
+		stmt, m_session.m_rowArraySize, m_session.cached_columns( stmtText, stmt ) ) );
+}
+
 inline statement_impl::recordset_type statement_impl::query( const std::string& stmtText )
 {
 	return m_session.query( stmtText );
 }
 
+inline statement_impl::recordset_type statement_impl::query_params( const std::string& stmtText )
+{
+	statement_ptr stmt = execute_prepared( stmtText );
+	result_type result( result_impl::create(
+		stmt, m_session.m_rowArraySize, m_session.cached_columns( stmtText, stmt ) ) );
+	return *result.recordsets( ).begin( );
+}
+
+inline statement_ptr statement_impl::execute_prepared( const std::string& stmtText )
+{
+	// parameters only live for one execution, the bound values belong to the caller's binders
+	std::vector< parameter > params;
+	params.swap( m_params );
+
+	statement_ptr stmt = m_session.prepare( stmtText );
+	for( size_t i = 0; i < params.size( ); ++i )
+	{
+		parameter& param = params[ i ];
+		session_impl::check_stmt_error( SQLBindParameter( *stmt,
+														  ( SQLUSMALLINT )i + 1,
+														  SQL_PARAM_INPUT,
+														  param.cType,
+														  param.sqlType,
+														  param.columnSize,
+														  param.decimalDigits,
+														  param.value,
+														  param.bufferLength,
+														  &param.indicator ),
+										*stmt );
+	}
+
+	session_impl::check_stmt_error( SQLExecute( *stmt ), *stmt );
+	return stmt;
+}
+
+inline void statement_impl::add_parameter( SQLSMALLINT cType,
+										   SQLSMALLINT sqlType,
+										   SQLULEN columnSize,
+										   SQLSMALLINT decimalDigits,
+										   const void* value,
+										   SQLLEN length )
+{
+	m_params.push_back( parameter {
+		cType, sqlType, columnSize, decimalDigits, ( SQLPOINTER )value, length, length } );
+}
+
+template<>
+inline void statement_impl::bind_parameter( const std::string& value, std::string& bound )
+{
+	add_parameter( SQL_C_CHAR,
+				   SQL_VARCHAR,
+				   std::max< size_t >( bound.length( ), 1 ),
+				   0,
+				   bound.c_str( ),
+				   ( SQLLEN )bound.length( ) );
+}
+
+template<>
+inline void statement_impl::bind_parameter( const std::string_view& value, std::string_view& bound )
+{
+	add_parameter( SQL_C_CHAR,
+				   SQL_VARCHAR,
+				   std::max< size_t >( bound.length( ), 1 ),
+				   0,
+				   bound.data( ),
+				   ( SQLLEN )bound.length( ) );
+}
+
+template<>
+inline void statement_impl::bind_parameter( const bool& value, bool& bound )
+{
+	add_parameter( SQL_C_BIT, SQL_BIT, 1, 0, &bound, sizeof( bound ) );
+}
+
+template<>
+inline void statement_impl::bind_parameter( const int8_t& value, int8_t& bound )
+{
+	add_parameter( SQL_C_STINYINT, SQL_TINYINT, 3, 0, &bound, sizeof( bound ) );
+}
+
+template<>
+inline void statement_impl::bind_parameter( const int16_t& value, int16_t& bound )
+{
+	add_parameter( SQL_C_SSHORT, SQL_SMALLINT, 5, 0, &bound, sizeof( bound ) );
+}
+
+template<>
+inline void statement_impl::bind_parameter( const int32_t& value, int32_t& bound )
+{
+	add_parameter( SQL_C_SLONG, SQL_INTEGER, 10, 0, &bound, sizeof( bound ) );
+}
+
+template<>
+inline void statement_impl::bind_parameter( const int64_t& value, int64_t& bound )
+{
+	add_parameter( SQL_C_SBIGINT, SQL_BIGINT, 19, 0, &bound, sizeof( bound ) );
+}
+
+template<>
+inline void statement_impl::bind_parameter( const float& value, float& bound )
+{
+	add_parameter( SQL_C_FLOAT, SQL_REAL, 7, 0, &bound, sizeof( bound ) );
+}
+
+template<>
+inline void statement_impl::bind_parameter( const double& value, double& bound )
+{
+	add_parameter( SQL_C_DOUBLE, SQL_DOUBLE, 15, 0, &bound, sizeof( bound ) );
+}
+
+template<>
+inline void statement_impl::bind_parameter( const datetime& value, SQL_TIMESTAMP_STRUCT& bound )
+{
+	add_parameter( SQL_C_TYPE_TIMESTAMP, SQL_TYPE_TIMESTAMP, 26, 6, &bound, sizeof( bound ) );
+}
+
+template<>
+inline auto statement_impl::get_binder_traits( const datetime& )
+{
+	struct binder_traits
+	{
+		using user_type = datetime;
+		using bound_type = SQL_TIMESTAMP_STRUCT;
+		using traits = binder_traits;
+
+		static SQL_TIMESTAMP_STRUCT transform( datetime from )
+		{
+			return to_timestamp( from );
+		}
+		static datetime transform( const SQL_TIMESTAMP_STRUCT& from )
+		{
+			return to_datetime( from );
+		}
+	};
+
+	return binder_traits( );
+}
+
 }  // namespace odbc
 }  // namespace dbclt
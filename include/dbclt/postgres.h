@@ -24,41 +24,77 @@ SOFTWARE.
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <date/date.h>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iterator>
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
+#include <shared_mutex>
 #include <string.h>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
 #include "data_exception.h"
 #include "field.h"
 #include "range.h"
 #include "util.h"
+#include "writer.h"
 
 #include "record.h"
 #include "recordset.h"
 #include "result.h"
+#include "typed_recordset.h"
 
 #include "session.h"
 #include "statement.h"
 #include "transaction.h"
+#include "executor.h"
+
+#include "arrow.h"
+#include "snapshot_writer.h"
 
 #include "postgres/common.h"
+#include "postgres/registry.h"
+#include "postgres/decoder.h"
+#include "postgres/composite.h"
+#include "postgres/numeric.h"
+#include "postgres/types.h"
 #include "postgres/listener.h"
+#include "postgres/cache.h"
+#include "postgres/copy.h"
 #include "postgres/result.h"
 #include "postgres/session.h"
 #include "postgres/statement.h"
+#include "postgres/parallel.h"
 
+#include "postgres/registry.inl"
 #include "postgres/listener.inl"
+#include "postgres/cache.inl"
+#include "postgres/copy.inl"
+#include "postgres/numeric.inl"
+#include "postgres/types.inl"
+#include "postgres/decoder.inl"
+#include "postgres/composite.inl"
 #include "postgres/result.inl"
 #include "postgres/session.inl"
 #include "postgres/statement.inl"
+#include "postgres/parallel.inl"
 
+#include "executor.inl"
 #include "recordset.inl"
 #include "result.inl"
 #include "session.inl"
 #include "statement.inl"
 #include "transaction.inl"
+#include "typed_recordset.inl"
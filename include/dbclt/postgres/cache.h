@@ -0,0 +1,105 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+namespace dbclt
+{
+namespace postgres
+{
+#ifndef WIN32
+class listener;
+#endif
+
+class result_cache
+{
+public:
+	using clock = std::chrono::steady_clock;
+
+	struct policy
+	{
+		std::chrono::milliseconds ttl;
+		std::vector< std::string > tables;
+	};
+
+	using policy_ptr = std::shared_ptr< const policy >;
+
+public:
+	result_cache( size_t capacity = 64 * 1024 * 1024, size_t shards = 16 );
+
+	void cache( const std::string& stmt,
+				std::chrono::milliseconds ttl,
+				const std::vector< std::string >& tables = { } );
+	policy_ptr find_policy( const std::string& stmt ) const;
+
+	result_ptr find( const std::string& key );
+	void insert( const std::string& key, result_ptr res, policy_ptr policy, uint64_t generation );
+
+	void invalidate( const std::string& table );
+#ifndef WIN32
+	void invalidate( const listener& notification );
+#endif
+	void clear( );
+
+	uint64_t generation( ) const;
+	size_t size( ) const;
+	size_t count( ) const;
+
+private:
+	struct entry
+	{
+		std::string key;
+		result_ptr result;
+		size_t size;
+		clock::time_point expires;
+		policy_ptr policy;
+	};
+
+	using entries = std::list< entry >;
+
+	struct shard
+	{
+		mutable std::mutex mutex;
+		entries lru;
+		std::unordered_map< std::string, entries::iterator > index;
+		size_t size { 0 };
+	};
+
+private:
+	shard& get_shard( const std::string& key );
+	void erase( shard& s, entries::iterator it );
+
+private:
+	size_t m_shardCapacity;
+	std::vector< shard > m_shards;
+	std::atomic< uint64_t > m_generation { 0 };
+
+	mutable std::shared_mutex m_policiesMutex;
+	std::unordered_map< std::string, policy_ptr > m_policies;
+};
+
+using result_cache_ptr = std::shared_ptr< result_cache >;
+
+}  // namespace postgres
+}  // namespace dbclt
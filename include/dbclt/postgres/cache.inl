@@ -0,0 +1,182 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+namespace dbclt
+{
+namespace postgres
+{
+inline result_cache::result_cache( size_t capacity, size_t shards )
+	: m_shardCapacity( capacity / std::max< size_t >( shards, 1 ) ),
+	  m_shards( std::max< size_t >( shards, 1 ) )
+{
+}
+
+inline void result_cache::cache( const std::string& stmt,
+								 std::chrono::milliseconds ttl,
+								 const std::vector< std::string >& tables )
+{
+	policy_ptr p( std::make_shared< policy >( policy { ttl, tables } ) );
+
+	std::unique_lock< std::shared_mutex > lock( m_policiesMutex );
+	m_policies[ stmt ] = p;
+}
+
+inline result_cache::policy_ptr result_cache::find_policy( const std::string& stmt ) const
+{
+	std::shared_lock< std::shared_mutex > lock( m_policiesMutex );
+	auto it = m_policies.find( stmt );
+	return it != m_policies.end( ) ? it->second : policy_ptr( );
+}
+
+inline result_ptr result_cache::find( const std::string& key )
+{
+	shard& s = get_shard( key );
+	std::lock_guard< std::mutex > lock( s.mutex );
+
+	auto it = s.index.find( key );
+	if( it == s.index.end( ) )
+		return result_ptr( );
+
+	if( it->second->expires <= clock::now( ) )
+	{
+		erase( s, it->second );
+		return result_ptr( );
+	}
+
+	s.lru.splice( s.lru.begin( ), s.lru, it->second );
+	return it->second->result;
+}
+
+inline void result_cache::insert( const std::string& key,
+								  result_ptr res,
+								  policy_ptr policy,
+								  uint64_t generation )
+{
+	const size_t size = PQresultMemorySize( res.get( ) ) + key.size( );
+	if( size > m_shardCapacity )
+		return;
+
+	shard& s = get_shard( key );
+	std::lock_guard< std::mutex > lock( s.mutex );
+
+	// an invalidation happened while the query was running, the result may be stale
+	if( generation != m_generation )
+		return;
+
+	auto it = s.index.find( key );
+	if( it != s.index.end( ) )
+		erase( s, it->second );
+
+	while( s.size + size > m_shardCapacity )
+		erase( s, std::prev( s.lru.end( ) ) );
+
+	s.lru.push_front( entry { key, res, size, clock::now( ) + policy->ttl, policy } );
+	s.index.emplace( key, s.lru.begin( ) );
+	s.size += size;
+}
+
+inline void result_cache::invalidate( const std::string& table )
+{
+	++m_generation;
+
+	for( shard& s : m_shards )
+	{
+		std::lock_guard< std::mutex > lock( s.mutex );
+		for( auto it = s.lru.begin( ); it != s.lru.end( ); )
+		{
+			const std::vector< std::string >& tables = it->policy->tables;
+			if( std::find( tables.begin( ), tables.end( ), table ) != tables.end( ) )
+				erase( s, it++ );
+			else
+				++it;
+		}
+	}
+}
+
+#ifndef WIN32
+inline void result_cache::invalidate( const listener& notification )
+{
+	if( !notification.channel( ).empty( ) )
+		invalidate( notification.channel( ) );
+	if( !notification.payload( ).empty( ) )
+		invalidate( notification.payload( ) );
+}
+#endif
+
+inline void result_cache::clear( )
+{
+	++m_generation;
+
+	for( shard& s : m_shards )
+	{
+		std::lock_guard< std::mutex > lock( s.mutex );
+		s.index.clear( );
+		s.lru.clear( );
+		s.size = 0;
+	}
+}
+
+inline uint64_t result_cache::generation( ) const
+{
+	return m_generation;
+}
+
+inline size_t result_cache::size( ) const
+{
+	size_t size = 0;
+	for( const shard& s : m_shards )
+	{
+		std::lock_guard< std::mutex > lock( s.mutex );
+		size += s.size;
+	}
+	return size;
+}
+
+inline size_t result_cache::count( ) const
+{
+	size_t count = 0;
+	for( const shard& s : m_shards )
+	{
+		std::lock_guard< std::mutex > lock( s.mutex );
+		count += s.lru.size( );
+	}
+	return count;
+}
+
+inline result_cache::shard& result_cache::get_shard( const std::string& key )
+{
+	return m_shards[ std::hash< std::string >( )( key ) % m_shards.size( ) ];
+}
+
+inline void result_cache::erase( shard& s, entries::iterator it )
+{
+	s.size -= it->size;
+	s.index.erase( it->key );
+	s.lru.erase( it );
+}
+
+}  // namespace postgres
+}  // namespace dbclt
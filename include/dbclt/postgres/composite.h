@@ -0,0 +1,78 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+namespace dbclt
+{
+namespace postgres
+{
+namespace detail
+{
+template< typename T, typename = void >
+struct has_decoder : std::false_type
+{
+};
+
+template< typename T >
+struct has_decoder< T, std::void_t< decltype( decoder< T >::accepts( Oid( ) ) ) > >
+	: std::true_type
+{
+};
+
+template< typename T >
+struct is_vector : std::false_type
+{
+};
+
+template< typename T, typename A >
+struct is_vector< std::vector< T, A > > : std::true_type
+{
+};
+
+// bounds checked reads of the binary record and array formats
+class binary_reader
+{
+public:
+	binary_reader( const char* value, int length );
+
+	int32_t read_int32( );
+	// null values have a negative length and no bytes
+	const char* read_bytes( int32_t length );
+
+private:
+	const char* m_value;
+	const char* m_end;
+};
+
+// one binary value of a column, composite field or array element, with the oid it was sent with.
+// handles the types with a decoder, the codec types, structs as composites through
+// structs::to_tuple and std::vector of any of them as one dimension arrays.
+// null values have a negative length
+template< typename T >
+struct value_decoder;
+
+}  // namespace detail
+}  // namespace postgres
+}  // namespace dbclt
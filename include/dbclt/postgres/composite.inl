@@ -0,0 +1,182 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <structs/to_tuple.h>
+
+namespace dbclt
+{
+namespace postgres
+{
+namespace detail
+{
+inline binary_reader::binary_reader( const char* value, int length )
+	: m_value( value ), m_end( value + std::max( length, 0 ) )
+{
+}
+
+inline int32_t binary_reader::read_int32( )
+{
+	return util::read_big< int32_t >( read_bytes( 4 ) );
+}
+
+inline const char* binary_reader::read_bytes( int32_t length )
+{
+	const char* value = m_value;
+	if( length > 0 )
+	{
+		if( m_end - m_value < length )
+			throw data_exception( "Truncated composite or array value" );
+		m_value += length;
+	}
+	return value;
+}
+
+template< typename T >
+inline T decode_composite_field( binary_reader& reader, const type_oids& types )
+{
+	const Oid type = ( Oid )reader.read_int32( );
+	const int32_t length = reader.read_int32( );
+	const char* value = reader.read_bytes( length );
+	if( !value_decoder< T >::accepts( type, types ) )
+		throw data_exception( "Invalid composite field type: " + std::to_string( type ) );
+	return value_decoder< T >::decode( type, value, length, types );
+}
+
+// the fields are read in order, braced initialization is sequenced left to right
+template< typename T, typename Tup, std::size_t... I >
+inline T
+decode_composite( binary_reader& reader, const type_oids& types, std::index_sequence< I... > )
+{
+	return T { decode_composite_field< std::decay_t< std::tuple_element_t< I, Tup > > >(
+		reader, types )... };
+}
+
+// field count, then the oid, length and bytes of each field
+template< typename T >
+inline T decode_composite( const char* value, int length, const type_oids& types )
+{
+	using Tup = decltype( structs::to_tuple( std::declval< T& >( ) ) );
+	if( length <= 0 )
+		return T { };
+
+	binary_reader reader( value, length );
+	const int32_t fields = reader.read_int32( );
+	if( fields != ( int32_t )std::tuple_size_v< Tup > )
+		throw data_exception( "Invalid composite field count: " + std::to_string( fields ) +
+							  ", expected: " + std::to_string( std::tuple_size_v< Tup > ) );
+
+	return decode_composite< T, Tup >( reader, types,
+									   std::make_index_sequence< std::tuple_size_v< Tup > > { } );
+}
+
+// dimension count, has nulls flag, element oid, size and lower bound of each dimension, then the
+// length and bytes of each element
+template< typename T >
+inline T decode_array( const char* value, int length, const type_oids& types )
+{
+	using element_type = typename T::value_type;
+	T result;
+	if( length <= 0 )
+		return result;
+
+	binary_reader reader( value, length );
+	const int32_t dimensions = reader.read_int32( );
+	reader.read_int32( );
+	const Oid type = ( Oid )reader.read_int32( );
+	if( dimensions == 0 )
+		return result;
+	if( dimensions != 1 )
+		throw data_exception( "Only one dimension arrays can be decoded" );
+	if( !value_decoder< element_type >::accepts( type, types ) )
+		throw data_exception( "Invalid array element type: " + std::to_string( type ) );
+
+	const int32_t size = reader.read_int32( );
+	reader.read_int32( );
+	if( size < 0 || size > length / 4 )
+		throw data_exception( "Invalid array size: " + std::to_string( size ) );
+
+	result.reserve( size );
+	for( int32_t i = 0; i < size; ++i )
+	{
+		const int32_t elementLength = reader.read_int32( );
+		const char* element = reader.read_bytes( elementLength );
+		result.push_back(
+			value_decoder< element_type >::decode( type, element, elementLength, types ) );
+	}
+	return result;
+}
+
+template< typename T >
+struct value_decoder
+{
+	static bool accepts( Oid type, const type_oids& types )
+	{
+		if constexpr( has_decoder< T >::value )
+			return decoder< T >::accepts( type );
+		else if constexpr( has_codec< T >::value )
+			return type != InvalidOid && type == codec_oid< T >( types );
+		else if constexpr( is_vector< T >::value )
+			return true;  // the element type is checked against the array header
+		else
+			return type == 2249 || type >= 16384;  // record or a user defined composite
+	}
+
+	static T decode( Oid type, const char* value, int length, const type_oids& types )
+	{
+		if constexpr( has_decoder< T >::value )
+		{
+			const std::string_view bytes = text_value( type, value, std::max( length, 0 ) );
+			return decoder< T >::decode( bytes.data( ), ( int )bytes.size( ) );
+		}
+		else if constexpr( has_codec< T >::value )
+			return codec< T >::decode( value, std::max( length, 0 ) );
+		else if constexpr( is_vector< T >::value )
+			return decode_array< T >( value, length, types );
+		else
+			return decode_composite< T >( value, length, types );
+	}
+};
+
+template< typename T >
+struct value_decoder< std::optional< T > >
+{
+	static bool accepts( Oid type, const type_oids& types )
+	{
+		return value_decoder< T >::accepts( type, types );
+	}
+
+	static std::optional< T >
+	decode( Oid type, const char* value, int length, const type_oids& types )
+	{
+		if( length < 0 )
+			return std::optional< T >( );
+		return value_decoder< T >::decode( type, value, length, types );
+	}
+};
+
+}  // namespace detail
+}  // namespace postgres
+}  // namespace dbclt
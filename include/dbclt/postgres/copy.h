@@ -0,0 +1,71 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+namespace dbclt
+{
+namespace postgres
+{
+// streams rows to a table with a binary copy, the members of each row have to match the
+// table's column types exactly: bool, int2, int4, int8, float4, float8, numeric as decimal,
+// text types, bytea as std::vector< uint8_t >, timestamp, time, interval, uuid and inet,
+// an empty std::optional is written as null
+class copy_writer
+{
+public:
+	copy_writer( conn_ptr conn, const std::string& table );
+	~copy_writer( );
+
+	template< typename Row >
+	void write( const Row& row );
+
+	// ends the copy, nothing is inserted when the writer is destroyed before
+	void finish( );
+
+	size_t rows( ) const;
+	size_t bytes( ) const;
+
+private:
+	template< typename T >
+	void write_field( const T& value );
+	void put( const void* data, size_t size );
+	void flush( );
+	void check_result( );
+
+private:
+	conn_ptr m_conn;
+	std::string m_table;
+	std::string m_buffer;
+	size_t m_rows { 0 };
+	size_t m_bytes { 0 };
+	bool m_open { false };
+
+private:
+	copy_writer( const copy_writer& ) = delete;
+	copy_writer& operator=( const copy_writer& ) = delete;
+};
+
+}  // namespace postgres
+}  // namespace dbclt
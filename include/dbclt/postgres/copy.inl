@@ -0,0 +1,191 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <structs/to_tuple.h>
+
+namespace dbclt
+{
+namespace postgres
+{
+inline copy_writer::copy_writer( conn_ptr conn, const std::string& table )
+	: m_conn( conn ), m_table( table )
+{
+	if( !m_conn )
+		throw data_exception( "Connection is not opened" );
+
+	const std::string stmt = "copy " + table + " from stdin with (format binary)";
+	result_ptr res( PQexec( m_conn.get( ), stmt.c_str( ) ) );
+	if( PQresultStatus( res.get( ) ) != PGRES_COPY_IN )
+		throw data_exception( "Copy failed: " + table + " -- " + PQerrorMessage( m_conn.get( ) ) );
+	m_open = true;
+
+	// signature, flags and header extension length
+	static const char header[] = "PGCOPY\n\377\r\n\0\0\0\0\0\0\0\0\0";
+	put( header, sizeof( header ) - 1 );
+}
+
+inline copy_writer::~copy_writer( )
+{
+	if( m_open && m_conn )
+	{
+		PQputCopyEnd( m_conn.get( ), "bulk insert aborted" );
+		while( result_ptr res = PQgetResult( m_conn.get( ) ) )
+			;
+	}
+}
+
+template< typename Row >
+inline void copy_writer::write( const Row& row )
+{
+	const auto values = structs::to_tuple( row );
+	const int16_t fields =
+		util::big_to_native16( ( int16_t )std::tuple_size_v< decltype( values ) > );
+	put( &fields, sizeof( fields ) );
+	std::apply( [ this ]( const auto&... value ) { ( write_field( value ), ... ); }, values );
+	++m_rows;
+
+	constexpr size_t flushSize = 1024 * 1024;
+	if( m_buffer.size( ) >= flushSize )
+		flush( );
+}
+
+template< typename T >
+inline void copy_writer::write_field( const T& value )
+{
+	auto put_value = [ this ]( auto bigEndian ) {
+		const int32_t length = util::big_to_native32( ( int32_t )sizeof( bigEndian ) );
+		put( &length, sizeof( length ) );
+		put( &bigEndian, sizeof( bigEndian ) );
+	};
+	auto put_bytes = [ this ]( std::string_view bytes ) {
+		const int32_t length = util::big_to_native32( ( int32_t )bytes.size( ) );
+		put( &length, sizeof( length ) );
+		put( bytes.data( ), bytes.size( ) );
+	};
+
+	if constexpr( std::is_same_v< T, bool > )
+		put_value( value );
+	else if constexpr( ( std::is_integral_v< T > || std::is_floating_point_v< T > ) &&
+					   sizeof( T ) == 2 )
+		put_value( util::big_to_native16( value ) );
+	else if constexpr( ( std::is_integral_v< T > || std::is_floating_point_v< T > ) &&
+					   sizeof( T ) == 4 )
+		put_value( util::big_to_native32( value ) );
+	else if constexpr( ( std::is_integral_v< T > || std::is_floating_point_v< T > ) &&
+					   sizeof( T ) == 8 )
+		put_value( util::big_to_native64( value ) );
+	else if constexpr( std::is_same_v< T, datetime > )
+	{
+		static const date::sys_days pgEpoch( date::year( 2000 ) / 1 / 1 );
+		put_value( util::big_to_native64( ( value - pgEpoch ).count( ) ) );
+	}
+	else if constexpr( std::is_same_v< T, time_of_day > )
+		put_value( util::big_to_native64( value.count( ) ) );
+	else if constexpr( std::is_same_v< T, uuid > )
+		put_value( value.bytes );
+	else if constexpr( std::is_same_v< T, decimal > )
+		put_bytes( detail::encode_numeric( value ) );
+	else if constexpr( std::is_same_v< T, interval > )
+		put_bytes( detail::encode_interval( value ) );
+	else if constexpr( std::is_same_v< T, inet > )
+		put_bytes( detail::encode_inet( value ) );
+	else if constexpr( std::is_same_v< T, std::vector< uint8_t > > )
+		put_bytes( std::string_view( ( const char* )value.data( ), value.size( ) ) );
+	else if constexpr( detail::has_codec< T >::value )
+		put_bytes( codec< T >::encode( value ) );
+	else if constexpr( std::is_convertible_v< const T&, std::string_view > )
+		put_bytes( value );
+	else
+	{
+		if( !value )
+		{
+			const int32_t null = -1;
+			put( &null, sizeof( null ) );
+		}
+		else
+			write_field( *value );
+	}
+}
+
+inline void copy_writer::finish( )
+{
+	const int16_t trailer = -1;
+	put( &trailer, sizeof( trailer ) );
+	flush( );
+
+	m_open = false;
+	if( PQputCopyEnd( m_conn.get( ), nullptr ) != 1 )
+		throw data_exception( "Copy failed: " + m_table + " -- " +
+							  PQerrorMessage( m_conn.get( ) ) );
+	check_result( );
+}
+
+inline size_t copy_writer::rows( ) const
+{
+	return m_rows;
+}
+
+inline size_t copy_writer::bytes( ) const
+{
+	return m_bytes;
+}
+
+inline void copy_writer::put( const void* data, size_t size )
+{
+	m_buffer.append( ( const char* )data, size );
+}
+
+inline void copy_writer::flush( )
+{
+	if( m_buffer.empty( ) )
+		return;
+
+	if( PQputCopyData( m_conn.get( ), m_buffer.data( ), ( int )m_buffer.size( ) ) != 1 )
+	{
+		m_open = false;
+		PQputCopyEnd( m_conn.get( ), "bulk insert aborted" );
+		check_result( );
+		throw data_exception( "Copy failed: " + m_table );
+	}
+
+	m_bytes += m_buffer.size( );
+	m_buffer.clear( );
+}
+
+inline void copy_writer::check_result( )
+{
+	// the copy's own result, then nothing
+	std::string error;
+	while( result_ptr res = PQgetResult( m_conn.get( ) ) )
+		if( PQresultStatus( res.get( ) ) != PGRES_COMMAND_OK && error.empty( ) )
+			error = PQresultErrorMessage( res.get( ) );
+
+	if( !error.empty( ) )
+		throw data_exception( "Copy failed: " + m_table + " -- " + error );
+}
+
+}  // namespace postgres
+}  // namespace dbclt
@@ -0,0 +1,467 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+namespace dbclt
+{
+namespace postgres
+{
+namespace detail
+{
+// null values have a zero length and decode to a default value
+template< typename T >
+inline T decode_integer( const char* value, int length )
+{
+	switch( length )
+	{
+	case 1: return ( T )( *( const int8_t* )value );
+	case 2: return ( T )util::read_big< int16_t >( value );
+	case 4: return ( T )util::read_big< int32_t >( value );
+	case 8: return ( T )util::read_big< int64_t >( value );
+	default: return T( );
+	}
+}
+
+template< typename T >
+inline T decode_floating( const char* value, int length )
+{
+	switch( length )
+	{
+	case 4: return ( T )util::read_big< float >( value );
+	case 8: return ( T )util::read_big< double >( value );
+	default: return T( );
+	}
+}
+
+inline bool is_text( Oid type )
+{
+	switch( type )
+	{
+	case 17:    // bytea
+	case 18:    // char
+	case 19:    // name
+	case 25:    // text
+	case 114:   // json
+	case 142:   // xml
+	case 1042:  // bpchar
+	case 1043:  // varchar
+	case 2275:  // cstring
+	case 3802:  // jsonb
+		return true;
+	default: return false;
+	}
+}
+
+// binary jsonb starts with a format version byte
+inline std::string_view text_value( Oid type, const char* value, int length )
+{
+	if( length > 0 && type == 3802 )
+		return std::string_view( value + 1, length - 1 );
+	return std::string_view( value, length );
+}
+
+inline std::string_view text_value( const PGresult* res, int row, int field )
+{
+	return text_value( PQftype( res, field ), PQgetvalue( res, row, field ),
+					   PQgetlength( res, row, field ) );
+}
+
+template< typename T >
+struct integer_decoder
+{
+	static bool accepts( Oid type )
+	{
+		switch( type )
+		{
+		case 18: return sizeof( T ) >= 1;  // char
+		case 21: return sizeof( T ) >= 2;  // int2
+		case 23:                           // int4
+		case 26: return sizeof( T ) >= 4;  // oid
+		case 20: return sizeof( T ) >= 8;  // int8
+		default: return false;
+		}
+	}
+
+	static T decode( const char* value, int length )
+	{
+		return detail::decode_integer< T >( value, length );
+	}
+
+	static T decode( const PGresult* res, int row, int field )
+	{
+		return decode( PQgetvalue( res, row, field ), PQgetlength( res, row, field ) );
+	}
+};
+
+}  // namespace detail
+
+template<>
+struct decoder< bool >
+{
+	static bool accepts( Oid type )
+	{
+		return type == 16;
+	}
+
+	static bool decode( const char* value, int length )
+	{
+		return length > 0 && *value != 0;
+	}
+
+	static bool decode( const PGresult* res, int row, int field )
+	{
+		return *PQgetvalue( res, row, field ) != 0;
+	}
+};
+
+template<>
+struct decoder< int8_t > : detail::integer_decoder< int8_t >
+{
+};
+
+template<>
+struct decoder< uint8_t > : detail::integer_decoder< uint8_t >
+{
+};
+
+template<>
+struct decoder< int16_t > : detail::integer_decoder< int16_t >
+{
+};
+
+template<>
+struct decoder< uint16_t > : detail::integer_decoder< uint16_t >
+{
+};
+
+template<>
+struct decoder< int32_t > : detail::integer_decoder< int32_t >
+{
+};
+
+template<>
+struct decoder< uint32_t > : detail::integer_decoder< uint32_t >
+{
+};
+
+template<>
+struct decoder< int64_t > : detail::integer_decoder< int64_t >
+{
+};
+
+template<>
+struct decoder< uint64_t > : detail::integer_decoder< uint64_t >
+{
+};
+
+template<>
+struct decoder< float >
+{
+	static bool accepts( Oid type )
+	{
+		return type == 700;
+	}
+
+	static float decode( const char* value, int length )
+	{
+		return detail::decode_floating< float >( value, length );
+	}
+
+	static float decode( const PGresult* res, int row, int field )
+	{
+		return decode( PQgetvalue( res, row, field ), PQgetlength( res, row, field ) );
+	}
+};
+
+template<>
+struct decoder< double >
+{
+	static bool accepts( Oid type )
+	{
+		return type == 700 || type == 701;
+	}
+
+	static double decode( const char* value, int length )
+	{
+		return detail::decode_floating< double >( value, length );
+	}
+
+	static double decode( const PGresult* res, int row, int field )
+	{
+		return decode( PQgetvalue( res, row, field ), PQgetlength( res, row, field ) );
+	}
+};
+
+// the values given as is are expected without the jsonb version byte, see text_value
+template<>
+struct decoder< std::string >
+{
+	static bool accepts( Oid type )
+	{
+		return detail::is_text( type );
+	}
+
+	static std::string decode( const char* value, int length )
+	{
+		return std::string( value, length );
+	}
+
+	static std::string decode( const PGresult* res, int row, int field )
+	{
+		return std::string( detail::text_value( res, row, field ) );
+	}
+};
+
+// the view is valid as long as the recordset is alive
+template<>
+struct decoder< std::string_view >
+{
+	static bool accepts( Oid type )
+	{
+		return detail::is_text( type );
+	}
+
+	static std::string_view decode( const char* value, int length )
+	{
+		return std::string_view( value, length );
+	}
+
+	static std::string_view decode( const PGresult* res, int row, int field )
+	{
+		return detail::text_value( res, row, field );
+	}
+};
+
+template<>
+struct decoder< datetime >
+{
+	static bool accepts( Oid type )
+	{
+		return type == 1082 || type == 1114 || type == 1184;
+	}
+
+	static datetime decode( const char* value, int length )
+	{
+		static const date::sys_days pgEpoch( date::year( 2000 ) / 1 / 1 );
+		switch( length )
+		{
+		case 4:
+		{
+			const int32_t days = util::read_big< int32_t >( value );
+			return datetime( pgEpoch + std::chrono::hours( days ) * 24 );
+		}
+		case 8:
+		{
+			const int64_t usecs = util::read_big< int64_t >( value );
+			return datetime( pgEpoch + std::chrono::microseconds( usecs ) );
+		}
+		default: return datetime( );
+		}
+	}
+
+	static datetime decode( const PGresult* res, int row, int field )
+	{
+		return decode( PQgetvalue( res, row, field ), PQgetlength( res, row, field ) );
+	}
+};
+
+template<>
+struct decoder< std::vector< uint8_t > >
+{
+	static bool accepts( Oid type )
+	{
+		return type == 17;
+	}
+
+	static std::vector< uint8_t > decode( const char* value, int length )
+	{
+		return std::vector< uint8_t >( ( const uint8_t* )value, ( const uint8_t* )value + length );
+	}
+
+	static std::vector< uint8_t > decode( const PGresult* res, int row, int field )
+	{
+		return decode( PQgetvalue( res, row, field ), PQgetlength( res, row, field ) );
+	}
+};
+
+template<>
+struct decoder< time_of_day >
+{
+	static bool accepts( Oid type )
+	{
+		return type == 1083 || type == 1266;
+	}
+
+	static time_of_day decode( const char* value, int length )
+	{
+		return detail::decode_time( value, length );
+	}
+
+	static time_of_day decode( const PGresult* res, int row, int field )
+	{
+		return decode( PQgetvalue( res, row, field ), PQgetlength( res, row, field ) );
+	}
+};
+
+template<>
+struct decoder< interval >
+{
+	static bool accepts( Oid type )
+	{
+		return type == 1186;
+	}
+
+	static interval decode( const char* value, int length )
+	{
+		return detail::decode_interval( value, length );
+	}
+
+	static interval decode( const PGresult* res, int row, int field )
+	{
+		return decode( PQgetvalue( res, row, field ), PQgetlength( res, row, field ) );
+	}
+};
+
+template<>
+struct decoder< uuid >
+{
+	static bool accepts( Oid type )
+	{
+		return type == 2950;
+	}
+
+	static uuid decode( const char* value, int length )
+	{
+		uuid result;
+		if( length == ( int )result.bytes.size( ) )
+			memcpy( result.bytes.data( ), value, result.bytes.size( ) );
+		return result;
+	}
+
+	static uuid decode( const PGresult* res, int row, int field )
+	{
+		return decode( PQgetvalue( res, row, field ), PQgetlength( res, row, field ) );
+	}
+};
+
+template<>
+struct decoder< inet >
+{
+	static bool accepts( Oid type )
+	{
+		return type == 869 || type == 650;
+	}
+
+	static inet decode( const char* value, int length )
+	{
+		return detail::decode_inet( value, length );
+	}
+
+	static inet decode( const PGresult* res, int row, int field )
+	{
+		return decode( PQgetvalue( res, row, field ), PQgetlength( res, row, field ) );
+	}
+};
+
+template<>
+struct decoder< decimal >
+{
+	static bool accepts( Oid type )
+	{
+		return type == 1700;
+	}
+
+	static decimal decode( const char* value, int length )
+	{
+		return detail::decode_numeric( value, length );
+	}
+
+	static decimal decode( const PGresult* res, int row, int field )
+	{
+		return decode( PQgetvalue( res, row, field ), PQgetlength( res, row, field ) );
+	}
+};
+
+template< typename T >
+struct decoder< std::optional< T > >
+{
+	static bool accepts( Oid type )
+	{
+		return decoder< T >::accepts( type );
+	}
+
+	static std::optional< T > decode( const PGresult* res, int row, int field )
+	{
+		if( PQgetisnull( res, row, field ) )
+			return std::optional< T >( );
+		return decoder< T >::decode( res, row, field );
+	}
+};
+
+namespace detail
+{
+// the column of a typed query or record: the types with a decoder are read directly, codec,
+// composite and array types are checked and decoded by value_decoder
+template< typename T >
+struct column_decoder
+{
+	static bool accepts( Oid type, const type_oids& types )
+	{
+		if constexpr( has_decoder< T >::value )
+			return decoder< T >::accepts( type );
+		else
+			return value_decoder< T >::accepts( type, types );
+	}
+
+	static T decode( const PGresult* res, int row, int field, const type_oids& types )
+	{
+		if constexpr( has_decoder< T >::value )
+			return decoder< T >::decode( res, row, field );
+		else
+			return value_decoder< T >::decode( PQftype( res, field ), PQgetvalue( res, row, field ),
+											   PQgetlength( res, row, field ), types );
+	}
+};
+
+template< typename T >
+struct column_decoder< std::optional< T > >
+{
+	static bool accepts( Oid type, const type_oids& types )
+	{
+		return column_decoder< T >::accepts( type, types );
+	}
+
+	static std::optional< T >
+	decode( const PGresult* res, int row, int field, const type_oids& types )
+	{
+		if( PQgetisnull( res, row, field ) )
+			return std::optional< T >( );
+		return column_decoder< T >::decode( res, row, field, types );
+	}
+};
+
+}  // namespace detail
+}  // namespace postgres
+}  // namespace dbclt
@@ -37,6 +37,9 @@ class listener
 public:
 	bool operator( )( );
 
+	std::string channel( ) const;
+	std::string payload( ) const;
+
 private:
 	listener( conn_ptr conn );
 
@@ -54,9 +54,20 @@ inline bool listener::operator( )( )
 							  strerror( errno ) );
 
 	PQconsumeInput( m_conn.get( ) );
+	m_notify = PQnotifies( m_conn.get( ) );
 	return true;
 }
 
+inline std::string listener::channel( ) const
+{
+	return m_notify ? m_notify->relname : "";
+}
+
+inline std::string listener::payload( ) const
+{
+	return m_notify ? m_notify->extra : "";
+}
+
 }  // namespace postgres
 }  // namespace dbclt
 
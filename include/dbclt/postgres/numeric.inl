@@ -0,0 +1,136 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+namespace dbclt
+{
+namespace postgres
+{
+namespace detail
+{
+constexpr uint16_t numeric_positive = 0x0000;
+constexpr uint16_t numeric_negative = 0x4000;
+constexpr uint16_t numeric_nan = 0xC000;
+
+inline decimal decode_numeric( const char* value, int length )
+{
+	if( length < 8 )
+		return decimal( );
+
+	const int ndigits = util::read_big< int16_t >( value );
+	const int weight = util::read_big< int16_t >( value + 2 );
+	const uint16_t sign = util::read_big< uint16_t >( value + 4 );
+	const int dscale = util::read_big< int16_t >( value + 6 );
+
+	if( sign == numeric_nan )
+		return decimal::nan( );
+	if( sign != numeric_positive && sign != numeric_negative )
+		throw data_exception( "Numeric infinity can't be represented as a decimal" );
+	if( dscale > decimal::max_scale || length < 8 + ndigits * 2 )
+		throw data_exception( "Invalid numeric value for a decimal" );
+
+	// the digits end ndigits - 1 - weight groups of four decimals after the point, the ones past
+	// the scale are dropped before they reach the coefficient so it never holds more digits
+	// than the result
+	const int exponent = dscale - 4 * ( ndigits - 1 - weight );
+	int used = ndigits;
+	int drop = 0;
+	if( exponent < 0 )
+	{
+		used -= std::min( -exponent / 4, ndigits );
+		drop = used ? -exponent % 4 : 0;
+	}
+
+	// two base 10000 digits per 128 bit multiplication
+	const char* digits = value + 8;
+	decimal::uint128 coefficient;
+	bool fits = true;
+	int i = 0;
+	for( ; i + 2 < used; i += 2 )
+	{
+		const uint32_t high = ( uint32_t )util::read_big< int16_t >( digits + i * 2 );
+		const uint32_t low = ( uint32_t )util::read_big< int16_t >( digits + i * 2 + 2 );
+		fits &= coefficient.mul_add( 100000000, high * 10000 + low );
+	}
+	for( ; i < used; ++i )
+	{
+		const uint32_t group = ( uint32_t )util::read_big< int16_t >( digits + i * 2 );
+		const int keep = i + 1 < used ? 4 : 4 - drop;
+		fits &= coefficient.mul_add( decimal::pow10[ keep ], group / decimal::pow10[ 4 - keep ] );
+	}
+	if( used > 0 && exponent > 0 )
+		fits &= coefficient.mul_pow10( exponent );
+
+	if( !fits )
+		throw data_exception( "Numeric value overflows a decimal" );
+	return decimal( coefficient, ( uint16_t )dscale, sign == numeric_negative );
+}
+
+inline std::string encode_numeric( const decimal& value )
+{
+	int16_t header[ 4 ] = { 0, 0, 0, 0 };
+	if( value.is_nan( ) )
+	{
+		header[ 2 ] = util::big_to_native16( ( int16_t )numeric_nan );
+		return std::string( ( const char* )header, sizeof( header ) );
+	}
+
+	// base 10000 digits from the least significant one, a partial fraction group is padded
+	int16_t digits[ 12 ];
+	int count = 0;
+	decimal::uint128 coefficient( value.coefficient( ) );
+	if( const int partial = value.scale( ) % 4 )
+		digits[ count++ ] = ( int16_t )( coefficient.div_mod( decimal::pow10[ partial ] ) *
+										 decimal::pow10[ 4 - partial ] );
+	while( !coefficient.is_zero( ) )
+		digits[ count++ ] = ( int16_t )coefficient.div_mod( 10000 );
+
+	// zero digits after the last significant one are implied by the weight
+	int last = 0;
+	while( last < count && digits[ last ] == 0 )
+		++last;
+
+	const int ndigits = count - last;
+	const int weight = ndigits ? count - 1 - ( value.scale( ) + 3 ) / 4 : 0;
+	header[ 0 ] = util::big_to_native16( ( int16_t )ndigits );
+	header[ 1 ] = util::big_to_native16( ( int16_t )weight );
+	header[ 2 ] = util::big_to_native16(
+		( int16_t )( value.is_negative( ) ? numeric_negative : numeric_positive ) );
+	header[ 3 ] = util::big_to_native16( ( int16_t )value.scale( ) );
+
+	std::string bytes;
+	bytes.reserve( sizeof( header ) + ndigits * sizeof( int16_t ) );
+	bytes.append( ( const char* )header, sizeof( header ) );
+	for( int i = count - 1; i >= last; --i )
+	{
+		const int16_t digit = util::big_to_native16( digits[ i ] );
+		bytes.append( ( const char* )&digit, sizeof( digit ) );
+	}
+	return bytes;
+}
+
+}  // namespace detail
+}  // namespace postgres
+}  // namespace dbclt
@@ -0,0 +1,69 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+namespace dbclt
+{
+namespace postgres
+{
+// reads a table or a query over several connections sharing one exported snapshot
+//
+// the rows are split in ranges of partitionKey, an integer column, or in ctid block ranges of
+// a table when no key is given, which needs PostgreSQL 14 or later. each connection reads one
+// range after the other and hands every range to consumer( size_t range, recordset& ) from its
+// own thread.
+template< typename F >
+void parallel_scan( const std::string& connInfo,
+					const std::string& source,
+					const std::string& partitionKey,
+					size_t connections,
+					F&& consumer );
+
+// the same scan merged in range order
+template< typename Row >
+std::vector< Row > parallel_scan( const std::string& connInfo,
+								  const std::string& source,
+								  const std::string& partitionKey,
+								  size_t connections );
+
+struct bulk_insert_stats
+{
+	size_t rows { 0 };
+	size_t bytes { 0 };
+	std::chrono::steady_clock::duration elapsed { };
+};
+
+// copies the rows to a table over several connections, each one streaming the next chunk of
+// the container through its own binary copy until none are left. with allOrNothing every
+// connection runs in a transaction committed only once all copies succeeded.
+template< typename T >
+std::vector< bulk_insert_stats > parallel_bulk_insert( const std::string& connInfo,
+													   const std::string& table,
+													   const T& container,
+													   size_t connections,
+													   bool allOrNothing = false );
+
+}  // namespace postgres
+}  // namespace dbclt
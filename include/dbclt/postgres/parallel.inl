@@ -0,0 +1,303 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+namespace dbclt
+{
+namespace postgres
+{
+namespace detail
+{
+// a few ranges or chunks per connection so a slow one does not hold the others back
+constexpr size_t ranges_per_connection = 8;
+
+inline bool is_query( const std::string& source )
+{
+	std::string word;
+	for( char c : source )
+	{
+		if( !isspace( ( unsigned char )c ) )
+			word += ( char )tolower( ( unsigned char )c );
+		else if( !word.empty( ) )
+			break;
+	}
+	return word == "select" || word == "with" || ( !word.empty( ) && word[ 0 ] == '(' );
+}
+
+inline std::vector< std::string > plan_scan( session& coordinator,
+											 const std::string& source,
+											 const std::string& partitionKey,
+											 size_t ranges )
+{
+	const bool query = is_query( source );
+	const std::string from =
+		"select * from " + ( query ? "(" + source + ") as scan" : source ) + " where ";
+
+	std::vector< std::string > stmts;
+	if( partitionKey.empty( ) )
+	{
+		if( query )
+			throw data_exception( "A partition key is needed to scan a query: " + source );
+
+		// before 14 a ctid range is not a tid range scan, every range would read the whole table
+		const int64_t version =
+			coordinator.query( "select current_setting('server_version_num')::int8" )
+				.begin( )
+				->get_int64( 0 );
+		if( version < 140000 )
+			throw data_exception( "A partition key is needed before PostgreSQL 14: " + source );
+
+		// the last range is left open, the table may have grown since its size was read
+		const int64_t blocks = coordinator
+								   .query_params( "select pg_relation_size($1::regclass) / "
+												  "current_setting('block_size')::int8",
+												  source )
+								   .begin( )
+								   ->get_int64( 0 );
+		const int64_t count = ( int64_t )ranges;
+		const int64_t step = std::max< int64_t >( ( blocks + count - 1 ) / count, 1 );
+		for( int64_t block = 0; block < blocks || stmts.empty( ); block += step )
+		{
+			std::string stmt = from + "ctid >= '(" + std::to_string( block ) + ",0)'::tid";
+			if( block + step < blocks )
+				stmt += " and ctid < '(" + std::to_string( block + step ) + ",0)'::tid";
+			stmts.push_back( stmt );
+		}
+		return stmts;
+	}
+
+	recordset bounds = coordinator.query( "select min(" + partitionKey + ")::int8, max(" +
+										  partitionKey + ")::int8 from (" + from +
+										  "true) as bounds" );
+	if( !bounds.begin( )->is_null( 0 ) )
+	{
+		const int64_t low = bounds.begin( )->get_int64( 0 );
+		const int64_t high = bounds.begin( )->get_int64( 1 );
+		const uint64_t span = ( uint64_t )high - ( uint64_t )low;
+		const uint64_t step = span / ranges + 1;
+		for( uint64_t offset = 0;; offset += step )
+		{
+			const uint64_t end = span - offset < step ? span : offset + step - 1;
+			stmts.push_back( from + partitionKey + " between " +
+							 std::to_string( ( int64_t )( ( uint64_t )low + offset ) ) + " and " +
+							 std::to_string( ( int64_t )( ( uint64_t )low + end ) ) );
+			if( end == span )
+				break;
+		}
+	}
+
+	// rows without a key are not in any range
+	stmts.push_back( from + partitionKey + " is null" );
+	return stmts;
+}
+
+}  // namespace detail
+
+template< typename F >
+inline void parallel_scan( const std::string& connInfo,
+						   const std::string& source,
+						   const std::string& partitionKey,
+						   size_t connections,
+						   F&& consumer )
+{
+	connections = std::max< size_t >( connections, 1 );
+
+	// the coordinator's transaction keeps the snapshot alive until every range is read
+	session coordinator;
+	coordinator.connect( connInfo );
+	coordinator.execute( "begin isolation level repeatable read" );
+	const std::string snapshot =
+		coordinator.query( "select pg_export_snapshot()" ).begin( )->get_string( 0 );
+	const std::vector< std::string > stmts = detail::plan_scan(
+		coordinator, source, partitionKey, connections * detail::ranges_per_connection );
+
+	std::atomic< size_t > next { 0 };
+	std::atomic< bool > failed { false };
+	std::mutex errorMutex;
+	std::exception_ptr error;
+
+	std::vector< std::thread > threads;
+	for( size_t i = 0; i < std::min( connections, stmts.size( ) ); ++i )
+		threads.emplace_back( [ & ]( ) {
+			try
+			{
+				session scanner;
+				scanner.connect( connInfo );
+				scanner.execute( "begin isolation level repeatable read" );
+				scanner.execute( "set transaction snapshot '" + snapshot + "'" );
+
+				for( size_t range; !failed && ( range = next++ ) < stmts.size( ); )
+				{
+					recordset rs = scanner.query( stmts[ range ] );
+					consumer( range, rs );
+				}
+				scanner.execute( "commit" );
+			}
+			catch( ... )
+			{
+				std::lock_guard< std::mutex > lock( errorMutex );
+				if( !error )
+					error = std::current_exception( );
+				failed = true;
+			}
+		} );
+
+	for( auto& thread : threads )
+		thread.join( );
+
+	coordinator.execute( "commit" );
+	if( error )
+		std::rethrow_exception( error );
+}
+
+template< typename Row >
+inline std::vector< Row > parallel_scan( const std::string& connInfo,
+										 const std::string& source,
+										 const std::string& partitionKey,
+										 size_t connections )
+{
+	std::mutex mutex;
+	std::map< size_t, std::vector< Row > > ranges;
+	auto collect = [ & ]( size_t range, recordset& rs ) {
+		std::vector< Row > rows;
+		rs.into( rows );
+		std::lock_guard< std::mutex > lock( mutex );
+		ranges.emplace( range, std::move( rows ) );
+	};
+	parallel_scan( connInfo, source, partitionKey, connections, collect );
+
+	size_t count = 0;
+	for( auto& range : ranges )
+		count += range.second.size( );
+
+	std::vector< Row > rows;
+	rows.reserve( count );
+	for( auto& range : ranges )
+		std::move( range.second.begin( ), range.second.end( ), std::back_inserter( rows ) );
+	return rows;
+}
+
+template< typename T >
+inline std::vector< bulk_insert_stats > parallel_bulk_insert( const std::string& connInfo,
+															  const std::string& table,
+															  const T& container,
+															  size_t connections,
+															  bool allOrNothing )
+{
+	using iterator = decltype( std::begin( container ) );
+
+	connections = std::max< size_t >( connections, 1 );
+	const size_t count = std::distance( std::begin( container ), std::end( container ) );
+	const size_t chunkSize =
+		std::max< size_t >( count / ( connections * detail::ranges_per_connection ), 1 );
+
+	std::vector< iterator > chunks;
+	for( iterator it = std::begin( container ); chunks.size( ) * chunkSize < count;
+		 std::advance( it, std::min( chunkSize, count - chunks.size( ) * chunkSize ) ) )
+		chunks.push_back( it );
+	chunks.push_back( std::end( container ) );
+	connections = std::max< size_t >( std::min( connections, chunks.size( ) - 1 ), 1 );
+
+	std::atomic< size_t > next { 0 };
+	std::atomic< bool > failed { false };
+	std::mutex mutex;
+	std::condition_variable gate;
+	size_t arrived = 0;
+	std::exception_ptr error;
+	auto fail = [ & ]( ) {
+		std::lock_guard< std::mutex > lock( mutex );
+		if( !error )
+			error = std::current_exception( );
+		failed = true;
+	};
+
+	std::vector< bulk_insert_stats > stats( connections );
+	std::vector< std::thread > threads;
+	for( size_t i = 0; i < connections; ++i )
+		threads.emplace_back( [ &, i ]( ) {
+			session loader;
+			bool transaction = false;
+			try
+			{
+				loader.connect( connInfo );
+				if( allOrNothing )
+				{
+					loader.begin_transaction( );
+					transaction = true;
+				}
+
+				const auto start = std::chrono::steady_clock::now( );
+				copy_writer writer = loader.backend( ).copy_in( table );
+				for( size_t chunk; !failed && ( chunk = next++ ) < chunks.size( ) - 1; )
+					for( iterator it = chunks[ chunk ]; it != chunks[ chunk + 1 ]; ++it )
+						writer.write( *it );
+				writer.finish( );
+
+				stats[ i ].rows = writer.rows( );
+				stats[ i ].bytes = writer.bytes( );
+				stats[ i ].elapsed = std::chrono::steady_clock::now( ) - start;
+			}
+			catch( ... )
+			{
+				fail( );
+			}
+
+			if( !allOrNothing )
+				return;
+
+			// the commit gate, every copy is done before any connection commits or rolls back
+			bool commit;
+			{
+				std::unique_lock< std::mutex > lock( mutex );
+				++arrived;
+				gate.notify_all( );
+				gate.wait( lock, [ & ]( ) { return arrived == connections; } );
+				commit = !failed;
+			}
+
+			try
+			{
+				if( transaction && commit )
+					loader.commit_transaction( );
+				else if( transaction )
+					loader.rollback_transaction( );
+			}
+			catch( ... )
+			{
+				fail( );
+			}
+		} );
+
+	for( auto& thread : threads )
+		thread.join( );
+
+	if( error )
+		std::rethrow_exception( error );
+
+	return stats;
+}
+
+}  // namespace postgres
+}  // namespace dbclt
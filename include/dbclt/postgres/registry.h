@@ -0,0 +1,108 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+namespace dbclt
+{
+namespace postgres
+{
+// binary codec of an application type (postgis geometry, enum, domain...), for instance:
+//	template<>
+//	struct codec< point >
+//	{
+//		static point decode( const char* value, int length );
+//		static std::string encode( const point& value );
+//	};
+// null values are decoded from a zero length, the sql type is given to type_registry::add
+template< typename T >
+struct codec;
+
+// oids of the registered types in one database, indexed by codec slot
+using type_oids = std::shared_ptr< const std::vector< Oid > >;
+
+// sql type names of the codecs, resolved to oids from pg_type when a session connects. sessions
+// to the same database can share a registry so the names are only looked up once
+class type_registry
+{
+public:
+	// the name is resolved like a cast, it can be schema qualified
+	template< typename T >
+	void add( const std::string& typeName );
+
+	// queries the database only when types were added since the last call
+	type_oids resolve( PGconn* conn );
+
+	// InvalidOid until resolved, or when the type does not exist in the database
+	template< typename T >
+	Oid oid( ) const;
+
+private:
+	mutable std::mutex m_mutex;
+	std::vector< std::string > m_names;
+	type_oids m_oids;
+};
+
+using type_registry_ptr = std::shared_ptr< type_registry >;
+
+namespace detail
+{
+template< typename T, typename = void >
+struct has_codec : std::false_type
+{
+};
+
+template< typename T >
+struct has_codec< T, std::void_t< decltype( codec< T >::decode( nullptr, 0 ) ) > >
+	: std::true_type
+{
+};
+
+// every codec type gets a process wide slot on first use
+template< typename T >
+size_t codec_slot( );
+
+template< typename T >
+Oid codec_oid( const type_oids& types );
+
+template< typename T >
+struct codec_binder_traits
+{
+	using user_type = T;
+	using bound_type = std::string;
+	using traits = codec_binder_traits;
+
+	static std::string transform( const T& from )
+	{
+		return codec< T >::encode( from );
+	}
+	static T transform( const std::string& from )
+	{
+		return codec< T >::decode( from.data( ), ( int )from.size( ) );
+	}
+};
+
+}  // namespace detail
+}  // namespace postgres
+}  // namespace dbclt
@@ -0,0 +1,131 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+namespace dbclt
+{
+namespace postgres
+{
+namespace detail
+{
+inline size_t next_codec_slot( )
+{
+	static std::atomic< size_t > next { 0 };
+	return next++;
+}
+
+template< typename T >
+inline size_t codec_slot( )
+{
+	static const size_t slot = next_codec_slot( );
+	return slot;
+}
+
+template< typename T >
+inline Oid codec_oid( const type_oids& types )
+{
+	const size_t slot = codec_slot< T >( );
+	return types && slot < types->size( ) ? ( *types )[ slot ] : InvalidOid;
+}
+
+// pg array literal of the names, unused slots are sent as null
+inline std::string type_names_array( const std::vector< std::string >& names )
+{
+	std::string array( "{" );
+	for( const std::string& name : names )
+	{
+		if( array.size( ) > 1 )
+			array.push_back( ',' );
+		if( name.empty( ) )
+		{
+			array.append( "NULL" );
+			continue;
+		}
+
+		array.push_back( '"' );
+		for( char c : name )
+		{
+			if( c == '"' || c == '\\' )
+				array.push_back( '\\' );
+			array.push_back( c );
+		}
+		array.push_back( '"' );
+	}
+	array.push_back( '}' );
+	return array;
+}
+
+}  // namespace detail
+
+template< typename T >
+inline void type_registry::add( const std::string& typeName )
+{
+	static_assert( detail::has_codec< T >::value, "codec< T > is not specialized" );
+	if( typeName.empty( ) )
+		throw data_exception( "Invalid type name" );
+
+	const size_t slot = detail::codec_slot< T >( );
+	std::lock_guard< std::mutex > lock( m_mutex );
+	if( m_names.size( ) <= slot )
+		m_names.resize( slot + 1 );
+	if( m_names[ slot ] != typeName )
+	{
+		m_names[ slot ] = typeName;
+		m_oids.reset( );
+	}
+}
+
+inline type_oids type_registry::resolve( PGconn* conn )
+{
+	std::lock_guard< std::mutex > lock( m_mutex );
+	if( m_oids || m_names.empty( ) )
+		return m_oids;
+
+	static const char* stmt = "select coalesce( to_regtype( name )::oid, 0 ) "
+							  "from unnest( $1::text[] ) with ordinality as types( name, slot ) "
+							  "order by slot";
+	const std::string names = detail::type_names_array( m_names );
+	const char* values[] = { names.c_str( ) };
+	result_ptr res( PQexecParams( conn, stmt, 1, nullptr, values, nullptr, nullptr, 0 ) );
+	if( PQresultStatus( res.get( ) ) != PGRES_TUPLES_OK ||
+		PQntuples( res.get( ) ) != ( int )m_names.size( ) )
+		throw data_exception( std::string( "Type lookup failed -- " ) + PQerrorMessage( conn ) );
+
+	auto oids = std::make_shared< std::vector< Oid > >( m_names.size( ) );
+	for( size_t i = 0; i < m_names.size( ); ++i )
+		( *oids )[ i ] = ( Oid )strtoul( PQgetvalue( res.get( ), ( int )i, 0 ), nullptr, 10 );
+	m_oids = oids;
+	return m_oids;
+}
+
+template< typename T >
+inline Oid type_registry::oid( ) const
+{
+	std::lock_guard< std::mutex > lock( m_mutex );
+	return detail::codec_oid< T >( m_oids );
+}
+
+}  // namespace postgres
+}  // namespace dbclt
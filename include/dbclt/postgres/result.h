@@ -38,8 +38,8 @@ class recordsets_iterator;
 template< typename BE >
 class recordset;
 
-template< typename BE, typename T >
-class recordset_iterator;
+template< typename BE >
+class recordset_row_iterator;
 
 namespace postgres
 {
@@ -51,7 +51,7 @@ public:
 	using recordsets_type = dbclt::range< recordsets_iterator >;
 
 	using recordset_value_type = dbclt::record< result_impl >;
-	using recordset_iterator = dbclt::recordset_iterator< result_impl, size_t >;
+	using recordset_iterator = dbclt::recordset_row_iterator< result_impl >;
 	using recordset_type = dbclt::recordset< result_impl >;
 
 public:
@@ -59,7 +59,7 @@ public:
 	{
 	}
 
-	static std::shared_ptr< result_impl > create( result_ptr result );
+	static std::shared_ptr< result_impl > create( result_ptr result, type_oids types = { } );
 
 	size_t affected_count( ) const;
 	int return_value( ) const;
@@ -70,8 +70,6 @@ public:
 	recordsets_value_type& get_recordset( recordsets_value_type* data );
 
 	recordset_type create_recordset( );
-	void next_record( size_t& data );
-	recordset_value_type& get_record( recordset_value_type& record, size_t data );
 
 	recordset_value_type* create_record( );
 	recordset_iterator begin( std::shared_ptr< recordset_value_type > record );
@@ -79,32 +77,54 @@ public:
 
 	const fields_type& record_fields( ) const;
 
-	bool is_null( size_t field ) const;
-
-	std::string get_string( size_t ndxField ) const;
-	bool get_bool( size_t ndxField ) const;
-	int8_t get_int8( size_t ndxField ) const;
-	int16_t get_int16( size_t ndxField ) const;
-	int32_t get_int32( size_t ndxField ) const;
-	int64_t get_int64( size_t ndxField ) const;
-	float get_float( size_t ndxField ) const;
-	double get_double( size_t ndxField ) const;
-	datetime get_date( size_t ndxField ) const;
-	datetime get_datetime( size_t ndxField ) const;
+	bool is_null( size_t row, size_t field ) const;
+
+	std::string get_string( size_t row, size_t ndxField ) const;
+	std::string_view get_string_view( size_t row, size_t ndxField ) const;
+	bool get_bool( size_t row, size_t ndxField ) const;
+	int8_t get_int8( size_t row, size_t ndxField ) const;
+	int16_t get_int16( size_t row, size_t ndxField ) const;
+	int32_t get_int32( size_t row, size_t ndxField ) const;
+	int64_t get_int64( size_t row, size_t ndxField ) const;
+	float get_float( size_t row, size_t ndxField ) const;
+	double get_double( size_t row, size_t ndxField ) const;
+	decimal get_decimal( size_t row, size_t ndxField ) const;
+	datetime get_date( size_t row, size_t ndxField ) const;
+	datetime get_datetime( size_t row, size_t ndxField ) const;
+	time_of_day get_time( size_t row, size_t ndxField ) const;
+	interval get_interval( size_t row, size_t ndxField ) const;
+	uuid get_uuid( size_t row, size_t ndxField ) const;
+	inet get_inet( size_t row, size_t ndxField ) const;
+
+	// codec types, composites decoded into structs and arrays into vectors
+	template< typename T >
+	T get_custom( size_t row, size_t ndxField ) const;
+
+	template< typename Row >
+	void check_row( ) const;
+
+	template< typename Row >
+	Row decode_row( size_t row ) const;
 
 private:
-	void init( std::shared_ptr< result_impl > ptr, result_ptr result );
+	template< typename Row, typename Tup, std::size_t... I >
+	void check_row( std::index_sequence< I... > ) const;
+
+	template< typename Row, typename Tup, std::size_t... I >
+	Row decode_row( size_t row, std::index_sequence< I... > ) const;
+
+	void init( std::shared_ptr< result_impl > ptr, result_ptr result, type_oids types );
 
-	const void* data( size_t field ) const;
+	const void* data( size_t row, size_t field ) const;
 
 	static field::type map_db_type( Oid type );
 
 private:
 	result_ptr m_stmtResult;
+	type_oids m_types;
 	fields_type m_fields;
 	size_t m_affectedRecords { 0 };
 	size_t m_records { 0 };
-	size_t m_current { 0 };
 };
 
 }  // namespace postgres
@@ -24,18 +24,21 @@ SOFTWARE.
 
 #pragma once
 
+#include <structs/to_tuple.h>
+
 namespace dbclt
 {
 namespace postgres
 {
-inline std::shared_ptr< result_impl > result_impl::create( result_ptr result )
+inline std::shared_ptr< result_impl > result_impl::create( result_ptr result, type_oids types )
 {
 	std::shared_ptr< result_impl > ptr( std::make_shared< result_impl >( ) );
-	ptr->init( ptr, result );
+	ptr->init( ptr, result, types );
 	return ptr;
 }
 
-inline void result_impl::init( std::shared_ptr< result_impl > ptr, result_ptr result )
+inline void
+result_impl::init( std::shared_ptr< result_impl > ptr, result_ptr result, type_oids types )
 {
 	const size_t fields = PQnfields( result.get( ) );
 	m_fields.resize( fields );
@@ -46,6 +49,7 @@ inline void result_impl::init( std::shared_ptr< result_impl > ptr, result_ptr re
 	m_affectedRecords = atoi( PQcmdTuples( result.get( ) ) );
 	m_records = PQntuples( result.get( ) );
 	m_stmtResult = result;
+	m_types = types;
 }
 
 inline size_t result_impl::affected_count( ) const
@@ -69,14 +73,14 @@ inline result_impl::recordset_value_type* result_impl::create_record( )
 }
 
 inline result_impl::recordset_iterator
-result_impl::begin( std::shared_ptr< recordset_value_type > record )
+result_impl::begin( std::shared_ptr< recordset_value_type > /*record*/ )
 {
-	return recordset_iterator( this, record, 0 );
+	return recordset_iterator( shared_from_this( ), 0 );
 }
 
 inline result_impl::recordset_iterator result_impl::end( )
 {
-	return recordset_iterator( this, m_records );
+	return recordset_iterator( shared_from_this( ), m_records );
 }
 
 inline result_impl::recordset_type result_impl::create_recordset( )
@@ -100,99 +104,205 @@ inline result_impl::recordsets_value_type& result_impl::get_recordset( recordset
 	return *data;
 }
 
-inline void result_impl::next_record( size_t& data )
+inline bool result_impl::is_null( size_t row, size_t field ) const
 {
-	data = ++m_current;
+	return PQgetisnull( m_stmtResult.get( ), row, field );
 }
 
-inline result_impl::recordset_value_type& result_impl::get_record( recordset_value_type& record,
-																   size_t data )
+inline std::string result_impl::get_string( size_t row, size_t field ) const
 {
-	return record;
+	// also checks the field index
+	const std::string_view value = get_string_view( row, field );
+	switch( m_fields[ field ].db_type( ) )
+	{
+	case dbclt::field::type::db_time: return dbclt::detail::format_time( get_time( row, field ) );
+	case dbclt::field::type::db_interval: return get_interval( row, field ).to_string( );
+	case dbclt::field::type::db_uuid: return get_uuid( row, field ).to_string( );
+	case dbclt::field::type::db_inet: return get_inet( row, field ).to_string( );
+	default: return std::string( value );
+	}
 }
 
-inline bool result_impl::is_null( size_t field ) const
+inline std::string_view result_impl::get_string_view( size_t row, size_t field ) const
 {
-	return PQgetisnull( m_stmtResult.get( ), m_current, field );
+	const char* value = ( const char* )data( row, field );
+	const int length = PQgetlength( m_stmtResult.get( ), row, field );
+
+	// binary jsonb starts with a format version byte
+	if( length > 0 && PQftype( m_stmtResult.get( ), field ) == 3802 )
+		return std::string_view( value + 1, length - 1 );
+	return std::string_view( value, length );
 }
 
-inline std::string result_impl::get_string( size_t field ) const
+inline bool result_impl::get_bool( size_t row, size_t field ) const
 {
-	return std::string( ( const char* )data( field ) );
+	return *( bool* )data( row, field );
 }
 
-inline bool result_impl::get_bool( size_t field ) const
+inline int8_t result_impl::get_int8( size_t row, size_t field ) const
 {
-	return *( bool* )data( field );
+	return get_int32( row, field );
 }
 
-inline int8_t result_impl::get_int8( size_t field ) const
+inline int16_t result_impl::get_int16( size_t row, size_t field ) const
 {
-	return get_int32( field );
+	return get_int32( row, field );
 }
 
-inline int16_t result_impl::get_int16( size_t field ) const
+inline int32_t result_impl::get_int32( size_t row, size_t field ) const
 {
-	return get_int32( field );
+	return util::big_to_native32( *( int32_t* )data( row, field ) );
 }
 
-inline int32_t result_impl::get_int32( size_t field ) const
+inline int64_t result_impl::get_int64( size_t row, size_t field ) const
 {
-	return util::big_to_native32( *( int32_t* )data( field ) );
+	return util::big_to_native64( *( int64_t* )data( row, field ) );
 }
 
-inline int64_t result_impl::get_int64( size_t field ) const
+inline float result_impl::get_float( size_t row, size_t field ) const
 {
-	return util::big_to_native64( *( int64_t* )data( field ) );
+	return get_double( row, field );
 }
 
-inline float result_impl::get_float( size_t field ) const
+inline double result_impl::get_double( size_t row, size_t field ) const
 {
-	return get_double( field );
+	const void* value = data( row, field );
+	if( PQftype( m_stmtResult.get( ), field ) == 1700 )
+		return detail::decode_numeric( ( const char* )value,
+									   PQgetlength( m_stmtResult.get( ), row, field ) )
+			.to_double( );
+	return util::big_to_native64( *( double* )value );
 }
 
-inline double result_impl::get_double( size_t field ) const
+inline decimal result_impl::get_decimal( size_t row, size_t field ) const
 {
-	return util::big_to_native64( *( double* )data( field ) );
+	const char* value = ( const char* )data( row, field );
+	const int length = PQgetlength( m_stmtResult.get( ), row, field );
+	switch( PQftype( m_stmtResult.get( ), field ) )
+	{
+	case 1700: return detail::decode_numeric( value, length );
+	case 20:  // int8
+	case 21:  // int2
+	case 23:  // int4
+		return decimal( detail::decode_integer< int64_t >( value, length ) );
+	default:
+		throw data_exception( "Invalid field type for a decimal: " + m_fields[ field ].name( ) );
+	}
 }
 
-inline datetime result_impl::get_date( size_t field ) const
+inline datetime result_impl::get_date( size_t row, size_t field ) const
 {
 	static const date::sys_days pgEpoch( date::year( 2000 ) / 1 / 1 );
 #if POSTGRESQL_INTEGER_DATETIME
 	// for servers built with the integer_datetime option
-	const int32_t ts = get_int32( field );
+	const int32_t ts = get_int32( row, field );
 	return datetime( pgEpoch + std::chrono::hours( ts ) * 24 );
 #else
 	// for servers built without the integer_datetime option
-	const double ts = get_double( field );
+	const double ts = get_double( row, field );
 	const int64_t secs = ( int64_t )ts;
 	const int64_t usecs = ( int64_t )( ( ts - secs ) * 1000000 );
 	return datetime( pgEpoch + std::chrono::seconds( secs ) + std::chrono::microseconds( usecs ) );
 #endif
 }
 
-inline datetime result_impl::get_datetime( size_t field ) const
+inline datetime result_impl::get_datetime( size_t row, size_t field ) const
 {
 	static const date::sys_days pgEpoch( date::year( 2000 ) / 1 / 1 );
 #if POSTGRESQL_INTEGER_DATETIME
 	// for servers built with the integer_datetime option
-	const int64_t ts = get_int64( field );
+	const int64_t ts = get_int64( row, field );
 	return datetime( pgEpoch + std::chrono::microseconds( ts ) );
 #else
 	// for servers built without the integer_datetime option
-	const double ts = get_double( field );
+	const double ts = get_double( row, field );
 	const int64_t secs = ( int64_t )ts;
 	const int64_t usecs = ( int64_t )( ( ts - secs ) * 1000000 );
 	return datetime( pgEpoch + std::chrono::seconds( secs ) + std::chrono::microseconds( usecs ) );
 #endif
 }
 
-inline const void* result_impl::data( size_t field ) const
+inline time_of_day result_impl::get_time( size_t row, size_t field ) const
+{
+	return detail::decode_time( ( const char* )data( row, field ),
+								PQgetlength( m_stmtResult.get( ), row, field ) );
+}
+
+inline interval result_impl::get_interval( size_t row, size_t field ) const
+{
+	return detail::decode_interval( ( const char* )data( row, field ),
+									PQgetlength( m_stmtResult.get( ), row, field ) );
+}
+
+inline uuid result_impl::get_uuid( size_t row, size_t field ) const
+{
+	uuid result;
+	const char* value = ( const char* )data( row, field );
+	if( PQgetlength( m_stmtResult.get( ), row, field ) == ( int )result.bytes.size( ) )
+		memcpy( result.bytes.data( ), value, result.bytes.size( ) );
+	return result;
+}
+
+inline inet result_impl::get_inet( size_t row, size_t field ) const
+{
+	return detail::decode_inet( ( const char* )data( row, field ),
+								PQgetlength( m_stmtResult.get( ), row, field ) );
+}
+
+template< typename T >
+inline T result_impl::get_custom( size_t row, size_t field ) const
+{
+	if( field >= m_fields.size( ) )
+		throw data_exception( "Invalid field index" );
+	if( !detail::column_decoder< T >::accepts( PQftype( m_stmtResult.get( ), field ), m_types ) )
+		throw data_exception( "Invalid field type for field: " + m_fields[ field ].name( ) );
+	return detail::column_decoder< T >::decode( m_stmtResult.get( ), ( int )row, ( int )field,
+												m_types );
+}
+
+template< typename Row >
+inline void result_impl::check_row( ) const
+{
+	using Tup = decltype( structs::to_tuple( std::declval< Row& >( ) ) );
+	if( std::tuple_size_v< Tup > != m_fields.size( ) )
+		throw data_exception( "Invalid field count: " + std::to_string( m_fields.size( ) ) +
+							  ", expected: " + std::to_string( std::tuple_size_v< Tup > ) );
+
+	check_row< Row, Tup >( std::make_index_sequence< std::tuple_size_v< Tup > > { } );
+}
+
+template< typename Row, typename Tup, std::size_t... I >
+inline void result_impl::check_row( std::index_sequence< I... > ) const
+{
+	const bool accepted[] = {
+		detail::column_decoder< std::decay_t< std::tuple_element_t< I, Tup > > >::accepts(
+			PQftype( m_stmtResult.get( ), I ), m_types )... };
+
+	for( size_t i = 0; i < sizeof...( I ); ++i )
+		if( !accepted[ i ] )
+			throw data_exception( "Invalid field type for field: " + m_fields[ i ].name( ) );
+}
+
+template< typename Row >
+inline Row result_impl::decode_row( size_t row ) const
+{
+	using Tup = decltype( structs::to_tuple( std::declval< Row& >( ) ) );
+	return decode_row< Row, Tup >( row, std::make_index_sequence< std::tuple_size_v< Tup > > { } );
+}
+
+template< typename Row, typename Tup, std::size_t... I >
+inline Row result_impl::decode_row( size_t row, std::index_sequence< I... > ) const
+{
+	const PGresult* res = m_stmtResult.get( );
+	return Row { detail::column_decoder< std::decay_t< std::tuple_element_t< I, Tup > > >::decode(
+		res, ( int )row, ( int )I, m_types )... };
+}
+
+inline const void* result_impl::data( size_t row, size_t field ) const
 {
 	if( field >= m_fields.size( ) )
 		throw data_exception( "Invalid field index" );
-	return PQgetvalue( m_stmtResult.get( ), m_current, field );
+	return PQgetvalue( m_stmtResult.get( ), row, field );
 }
 
 inline field::type result_impl::map_db_type( Oid type )
@@ -206,6 +316,7 @@ inline field::type result_impl::map_db_type( Oid type )
 	case 1042:  // bpchar
 	case 142:   // xml
 	case 114:   // json
+	case 3802:  // jsonb
 		return field::type::db_string;
 
 	case 17:  // bytea
@@ -216,12 +327,24 @@ inline field::type result_impl::map_db_type( Oid type )
 
 	case 702:   // abstime
 	case 703:   // reltime
-	case 1083:  // time
 	case 1114:  // timestamp
 	case 1184:  // timestamptz
-	case 1266:  // timetz
 		return field::type::db_datetime;
 
+	case 1083:  // time
+	case 1266:  // timetz
+		return field::type::db_time;
+
+	case 1186:  // interval
+		return field::type::db_interval;
+
+	case 2950:  // uuid
+		return field::type::db_uuid;
+
+	case 650:  // cidr
+	case 869:  // inet
+		return field::type::db_inet;
+
 	case 700:   // float4
 	case 701:   // float8
 	case 1700:  // numeric
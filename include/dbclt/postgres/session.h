@@ -63,13 +63,29 @@ public:
 	recordset_type query( const std::string& stmt );
 	recordset_type query_as_string( const std::string& stmt );
 
+	// binary copy of the rows, see copy_writer for the member types
+	copy_writer copy_in( const std::string& table );
+
+	template< typename T >
+	void bulk_insert( const std::string& table, const T& container );
+
 #ifndef WIN32
 	listener listen( const std::string& table );
 #endif
 
+	void set_cache( result_cache_ptr cache );
+	result_cache_ptr cache( ) const;
+
+	// codec types of the application, resolved when connecting
+	void set_types( type_registry_ptr types );
+	type_registry_ptr types( ) const;
+
 private:
 	conn_ptr m_conn;
 	size_t m_transaction { 0 };
+	result_cache_ptr m_cache;
+	type_registry_ptr m_types;
+	type_oids m_typeOids;
 
 	friend statement_impl;
 };
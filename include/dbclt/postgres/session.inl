@@ -68,12 +68,14 @@ inline void session_impl::connect( const std::string& connInfo )
 	if( PQstatus( conn.get( ) ) != CONNECTION_OK )
 		throw data_exception( "Connection to database failed: " + connInfo + " -- " +
 							  PQerrorMessage( conn.get( ) ) );
+	m_typeOids = m_types ? m_types->resolve( conn.get( ) ) : type_oids( );
 	m_conn = conn;
 }
 
 inline void session_impl::disconnect( )
 {
 	m_conn.reset( );
+	m_typeOids.reset( );
 }
 
 inline session_impl::result_type session_impl::execute( const std::string& stmt )
@@ -86,7 +88,42 @@ inline session_impl::result_type session_impl::execute( const std::string& stmt
 		throw data_exception( "Command failed: " + stmt + " -- " +
 							  PQerrorMessage( m_conn.get( ) ) );
 
-	return result_type( result_impl::create( res ) );
+	return result_type( result_impl::create( res, m_typeOids ) );
+}
+
+inline copy_writer session_impl::copy_in( const std::string& table )
+{
+	return copy_writer( m_conn, table );
+}
+
+template< typename T >
+inline void session_impl::bulk_insert( const std::string& table, const T& container )
+{
+	copy_writer writer( m_conn, table );
+	for( const auto& row : container )
+		writer.write( row );
+	writer.finish( );
+}
+
+inline void session_impl::set_cache( result_cache_ptr cache )
+{
+	m_cache = cache;
+}
+
+inline result_cache_ptr session_impl::cache( ) const
+{
+	return m_cache;
+}
+
+inline void session_impl::set_types( type_registry_ptr types )
+{
+	m_types = types;
+	m_typeOids = m_types && m_conn ? m_types->resolve( m_conn.get( ) ) : type_oids( );
+}
+
+inline type_registry_ptr session_impl::types( ) const
+{
+	return m_types;
 }
 
 #ifndef WIN32
@@ -57,9 +57,16 @@ public:
 	template< typename T >
 	auto get_binder_traits( const T& )
 	{
-		return binder_traits< T >( );
+		if constexpr( detail::has_codec< T >::value )
+			return detail::codec_binder_traits< T >( );
+		else
+			return binder_traits< T >( );
 	}
 
+private:
+	std::string cache_key( const std::string& stmt ) const;
+	recordset_type create_recordset( result_ptr res );
+
 private:
 	using paramTypes = std::vector< Oid >;
 	using paramValues = std::vector< const char* >;
@@ -68,6 +75,8 @@ private:
 
 private:
 	conn_ptr m_conn;
+	result_cache_ptr m_cache;
+	type_oids m_types;
 	result_ptr m_result;
 	paramTypes m_paramTypes;
 	paramValues m_paramValues;
@@ -37,7 +37,8 @@ struct type_traits< datetime >
 
 namespace postgres
 {
-inline statement_impl::statement_impl( session_impl& session ) : m_conn( session.m_conn )
+inline statement_impl::statement_impl( session_impl& session )
+	: m_conn( session.m_conn ), m_cache( session.m_cache ), m_types( session.m_typeOids )
 {
 }
 
@@ -52,7 +53,7 @@ inline statement_impl::result_type statement_impl::execute( const std::string& s
 		throw data_exception( "Command failed: " + stmt + " -- " + PQresStatus( status ) + " -- " +
 							  PQerrorMessage( m_conn.get( ) ) );
 
-	return result_type( result_impl::create( res ) );
+	return result_type( result_impl::create( res, m_types ) );
 }
 
 inline statement_impl::result_type statement_impl::execute_params( const std::string& stmt )
@@ -73,7 +74,7 @@ inline statement_impl::result_type statement_impl::execute_params( const std::st
 		throw data_exception( "Command failed: " + stmt + " -- " + PQresStatus( status ) + " -- " +
 							  PQerrorMessage( m_conn.get( ) ) );
 
-	return result_type( result_impl::create( res ) );
+	return result_type( result_impl::create( res, m_types ) );
 }
 
 inline statement_impl::recordset_type statement_impl::query( const std::string& stmt )
@@ -81,6 +82,15 @@ inline statement_impl::recordset_type statement_impl::query( const std::string&
 	if( !m_conn )
 		throw data_exception( "Connection is not opened" );
 
+	result_cache::policy_ptr policy;
+	uint64_t generation = 0;
+	if( m_cache && ( policy = m_cache->find_policy( stmt ) ) )
+	{
+		if( result_ptr res = m_cache->find( stmt ) )
+			return create_recordset( res );
+		generation = m_cache->generation( );
+	}
+
 	result_ptr res(
 		PQexecParams( m_conn.get( ), stmt.c_str( ), 0, nullptr, nullptr, nullptr, nullptr, 1 ) );
 	ExecStatusType status = PQresultStatus( res.get( ) );
@@ -88,8 +98,10 @@ inline statement_impl::recordset_type statement_impl::query( const std::string&
 		throw data_exception( "Command failed: " + stmt + " -- " + PQresStatus( status ) + " -- " +
 							  PQerrorMessage( m_conn.get( ) ) );
 
-	result_type result( result_impl::create( res ) );
-	return *result.recordsets( ).begin( );
+	if( policy )
+		m_cache->insert( stmt, res, policy, generation );
+
+	return create_recordset( res );
 }
 
 inline statement_impl::recordset_type statement_impl::query_params( const std::string& stmt )
@@ -97,6 +109,17 @@ inline statement_impl::recordset_type statement_impl::query_params( const std::s
 	if( !m_conn )
 		throw data_exception( "Connection is not opened" );
 
+	std::string key;
+	result_cache::policy_ptr policy;
+	uint64_t generation = 0;
+	if( m_cache && ( policy = m_cache->find_policy( stmt ) ) )
+	{
+		key = cache_key( stmt );
+		if( result_ptr res = m_cache->find( key ) )
+			return create_recordset( res );
+		generation = m_cache->generation( );
+	}
+
 	result_ptr res( PQexecParams( m_conn.get( ),
 								  stmt.c_str( ),
 								  m_paramTypes.size( ),
@@ -110,10 +133,40 @@ inline statement_impl::recordset_type statement_impl::query_params( const std::s
 		throw data_exception( "Command failed: " + stmt + " -- " + PQresStatus( status ) + " -- " +
 							  PQerrorMessage( m_conn.get( ) ) );
 
-	result_type result( result_impl::create( res ) );
+	if( policy )
+		m_cache->insert( key, res, policy, generation );
+
+	return create_recordset( res );
+}
+
+inline statement_impl::recordset_type statement_impl::create_recordset( result_ptr res )
+{
+	result_type result( result_impl::create( res, m_types ) );
 	return *result.recordsets( ).begin( );
 }
 
+inline std::string statement_impl::cache_key( const std::string& stmt ) const
+{
+	// fnv-1a over the parameter types and bytes
+	uint64_t hash = 14695981039346656037ull;
+	auto update = [ &hash ]( const void* data, size_t size ) {
+		for( size_t i = 0; i < size; ++i )
+			hash = ( hash ^ ( ( const uint8_t* )data )[ i ] ) * 1099511628211ull;
+	};
+
+	for( size_t i = 0; i < m_paramValues.size( ); ++i )
+	{
+		update( &m_paramTypes[ i ], sizeof( Oid ) );
+		update( &m_paramLengths[ i ], sizeof( int ) );
+		update( m_paramValues[ i ], m_paramLengths[ i ] );
+	}
+
+	std::string key( stmt );
+	key.push_back( '\0' );
+	key.append( ( const char* )&hash, sizeof( hash ) );
+	return key;
+}
+
 template<>
 inline void statement_impl::bind_parameter( const std::string& value, std::string& bound )
 {
@@ -204,6 +257,76 @@ inline void statement_impl::bind_parameter( const datetime& value, int64_t& boun
 	m_paramFormats.emplace_back( 1 );
 }
 
+template<>
+inline void statement_impl::bind_parameter( const decimal& value, std::string& bound )
+{
+	m_paramTypes.emplace_back( 1700 );
+	m_paramValues.emplace_back( bound.data( ) );
+	m_paramLengths.emplace_back( ( int )bound.length( ) );
+	m_paramFormats.emplace_back( 1 );
+}
+
+template<>
+inline void statement_impl::bind_parameter( const time_of_day& value, int64_t& bound )
+{
+	m_paramTypes.emplace_back( 1083 );
+	m_paramValues.emplace_back( ( const char* )( const void* )&bound );
+	m_paramLengths.emplace_back( ( int )sizeof( bound ) );
+	m_paramFormats.emplace_back( 1 );
+}
+
+template<>
+inline void statement_impl::bind_parameter( const interval& value, std::string& bound )
+{
+	m_paramTypes.emplace_back( 1186 );
+	m_paramValues.emplace_back( bound.data( ) );
+	m_paramLengths.emplace_back( ( int )bound.length( ) );
+	m_paramFormats.emplace_back( 1 );
+}
+
+template<>
+inline void statement_impl::bind_parameter( const uuid& value, uuid& bound )
+{
+	m_paramTypes.emplace_back( 2950 );
+	m_paramValues.emplace_back( ( const char* )bound.bytes.data( ) );
+	m_paramLengths.emplace_back( ( int )bound.bytes.size( ) );
+	m_paramFormats.emplace_back( 1 );
+}
+
+template<>
+inline void statement_impl::bind_parameter( const inet& value, std::string& bound )
+{
+	m_paramTypes.emplace_back( value.cidr ? 650 : 869 );
+	m_paramValues.emplace_back( bound.data( ) );
+	m_paramLengths.emplace_back( ( int )bound.length( ) );
+	m_paramFormats.emplace_back( 1 );
+}
+
+template<>
+inline void statement_impl::bind_parameter( const std::vector< uint8_t >& value,
+											std::vector< uint8_t >& bound )
+{
+	m_paramTypes.emplace_back( 17 );
+	m_paramValues.emplace_back( ( const char* )bound.data( ) );
+	m_paramLengths.emplace_back( ( int )bound.size( ) );
+	m_paramFormats.emplace_back( 1 );
+}
+
+// application types are sent in binary through their codec
+template< typename T1, typename T2 >
+inline void statement_impl::bind_parameter( const T1& value, T2& bound )
+{
+	static_assert( detail::has_codec< T1 >::value, "no parameter binding for this type" );
+	const Oid type = detail::codec_oid< T1 >( m_types );
+	if( type == InvalidOid )
+		throw data_exception( "Parameter type is not registered" );
+
+	m_paramTypes.emplace_back( type );
+	m_paramValues.emplace_back( bound.data( ) );
+	m_paramLengths.emplace_back( ( int )bound.length( ) );
+	m_paramFormats.emplace_back( 1 );
+}
+
 template<>
 inline auto statement_impl::get_binder_traits( const int32_t& )
 {
@@ -300,5 +423,93 @@ inline auto statement_impl::get_binder_traits( const datetime& )
 	return binder_traits( );
 }
 
+template<>
+inline auto statement_impl::get_binder_traits( const decimal& )
+{
+	struct binder_traits
+	{
+		using user_type = decimal;
+		using bound_type = std::string;
+		using traits = binder_traits;
+
+		static std::string transform( const decimal& from )
+		{
+			return detail::encode_numeric( from );
+		}
+		static decimal transform( const std::string& from )
+		{
+			return detail::decode_numeric( from.data( ), ( int )from.size( ) );
+		}
+	};
+
+	return binder_traits( );
+}
+
+template<>
+inline auto statement_impl::get_binder_traits( const time_of_day& )
+{
+	struct binder_traits
+	{
+		using user_type = time_of_day;
+		using bound_type = int64_t;
+		using traits = binder_traits;
+
+		static int64_t transform( time_of_day from )
+		{
+			return util::big_to_native64( from.count( ) );
+		}
+		static time_of_day transform( int64_t from )
+		{
+			return time_of_day( util::big_to_native64( from ) );
+		}
+	};
+
+	return binder_traits( );
+}
+
+template<>
+inline auto statement_impl::get_binder_traits( const interval& )
+{
+	struct binder_traits
+	{
+		using user_type = interval;
+		using bound_type = std::string;
+		using traits = binder_traits;
+
+		static std::string transform( const interval& from )
+		{
+			return detail::encode_interval( from );
+		}
+		static interval transform( const std::string& from )
+		{
+			return detail::decode_interval( from.data( ), ( int )from.size( ) );
+		}
+	};
+
+	return binder_traits( );
+}
+
+template<>
+inline auto statement_impl::get_binder_traits( const inet& )
+{
+	struct binder_traits
+	{
+		using user_type = inet;
+		using bound_type = std::string;
+		using traits = binder_traits;
+
+		static std::string transform( const inet& from )
+		{
+			return detail::encode_inet( from );
+		}
+		static inet transform( const std::string& from )
+		{
+			return detail::decode_inet( from.data( ), ( int )from.size( ) );
+		}
+	};
+
+	return binder_traits( );
+}
+
 }  // namespace postgres
 }  // namespace dbclt
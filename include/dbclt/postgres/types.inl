@@ -0,0 +1,109 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+namespace dbclt
+{
+namespace postgres
+{
+namespace detail
+{
+// address families as sent by the server, not the platform's AF_ values
+constexpr uint8_t pgsql_af_inet = 2;
+constexpr uint8_t pgsql_af_inet6 = 3;
+
+inline time_of_day decode_time( const char* value, int length )
+{
+	if( length < 8 )
+		return time_of_day( );
+
+	int64_t usecs = util::read_big< int64_t >( value );
+	if( length >= 12 )
+	{
+		// timetz: the zone is in seconds west of utc, the time is normalized to utc
+		constexpr int64_t usecsPerDay = 86400LL * 1000000;
+		const int32_t zone = util::read_big< int32_t >( value + 8 );
+		usecs = ( ( usecs + zone * 1000000LL ) % usecsPerDay + usecsPerDay ) % usecsPerDay;
+	}
+	return time_of_day( usecs );
+}
+
+inline interval decode_interval( const char* value, int length )
+{
+	interval result;
+	if( length < 16 )
+		return result;
+
+	result.microseconds = util::read_big< int64_t >( value );
+	result.days = util::read_big< int32_t >( value + 8 );
+	result.months = util::read_big< int32_t >( value + 12 );
+	return result;
+}
+
+inline std::string encode_interval( const interval& value )
+{
+	const int64_t usecs = util::big_to_native64( value.microseconds );
+	const int32_t days = util::big_to_native32( value.days );
+	const int32_t months = util::big_to_native32( value.months );
+
+	std::string bytes;
+	bytes.reserve( 16 );
+	bytes.append( ( const char* )&usecs, sizeof( usecs ) );
+	bytes.append( ( const char* )&days, sizeof( days ) );
+	bytes.append( ( const char* )&months, sizeof( months ) );
+	return bytes;
+}
+
+inline inet decode_inet( const char* value, int length )
+{
+	// family, prefix bits, is cidr, address length, address
+	inet result;
+	if( length < 4 || length < 4 + ( uint8_t )value[ 3 ] || ( uint8_t )value[ 3 ] > 16 )
+		return result;
+
+	result.address_family =
+		( uint8_t )value[ 0 ] == pgsql_af_inet6 ? inet::family::ipv6 : inet::family::ipv4;
+	result.bits = ( uint8_t )value[ 1 ];
+	result.cidr = value[ 2 ] != 0;
+	memcpy( result.address.data( ), value + 4, ( uint8_t )value[ 3 ] );
+	return result;
+}
+
+inline std::string encode_inet( const inet& value )
+{
+	const bool ipv6 = value.address_family == inet::family::ipv6;
+	std::string bytes;
+	bytes.reserve( 20 );
+	bytes.push_back( ( char )( ipv6 ? pgsql_af_inet6 : pgsql_af_inet ) );
+	bytes.push_back( ( char )value.bits );
+	bytes.push_back( ( char )value.cidr );
+	bytes.push_back( ( char )( ipv6 ? 16 : 4 ) );
+	bytes.append( ( const char* )value.address.data( ), ipv6 ? 16 : 4 );
+	return bytes;
+}
+
+}  // namespace detail
+}  // namespace postgres
+}  // namespace dbclt
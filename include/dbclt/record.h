@@ -25,11 +25,17 @@ SOFTWARE.
 #pragma once
 
 #include "datetime.h"
+#include "decimal.h"
+#include "types.h"
 
 #include <optional>
+#include <string_view>
 
 namespace dbclt
 {
+template< typename BE >
+class recordset;
+
 template< typename BE >
 class record
 {
@@ -40,6 +46,10 @@ public:
 public:
 	record( ) = default;
 	record( record_ptr impl );
+	record( record_ptr impl, size_t row );
+
+	// the row of a random access result, always 0 for a streamed one
+	size_t row( ) const;
 
 	const fields_type& fields( ) const;
 	size_t field_index( const std::string& nameField ) const;
@@ -53,6 +63,16 @@ public:
 	std::string get_string( size_t ndxField ) const;
 	std::string get_string( const std::string& nameField ) const;
 
+	std::string_view get_string_view( size_t ndxField ) const;
+	std::string_view get_string_view( const std::string& nameField ) const;
+
+	// passes the field to callback( const char* data, size_t size ) in one or more chunks,
+	// returns false when the field is null
+	template< typename F >
+	bool read_blob( size_t ndxField, F&& callback ) const;
+	template< typename F >
+	bool read_blob( const std::string& nameField, F&& callback ) const;
+
 	bool get_bool( size_t ndxField ) const;
 	bool get_bool( const std::string& nameField ) const;
 
@@ -74,12 +94,35 @@ public:
 	double get_double( size_t ndxField ) const;
 	double get_double( const std::string& nameField ) const;
 
+	// only for backends decoding exact numerics
+	decimal get_decimal( size_t ndxField ) const;
+	decimal get_decimal( const std::string& nameField ) const;
+
 	datetime get_date( size_t ndxField ) const;
 	datetime get_date( const std::string& nameField ) const;
 
 	datetime get_datetime( size_t ndxField ) const;
 	datetime get_datetime( const std::string& nameField ) const;
 
+	// only for backends decoding these types natively
+	time_of_day get_time( size_t ndxField ) const;
+	time_of_day get_time( const std::string& nameField ) const;
+
+	interval get_interval( size_t ndxField ) const;
+	interval get_interval( const std::string& nameField ) const;
+
+	uuid get_uuid( size_t ndxField ) const;
+	uuid get_uuid( const std::string& nameField ) const;
+
+	inet get_inet( size_t ndxField ) const;
+	inet get_inet( const std::string& nameField ) const;
+
+	// application types decoded by the backend, e.g. postgres codecs and composites
+	template< typename T >
+	T get_custom( size_t ndxField ) const;
+	template< typename T >
+	T get_custom( const std::string& nameField ) const;
+
 	std::optional< std::string > get_nullable_as_string( size_t ndxField ) const;
 	std::optional< std::string > get_nullable_as_string( const std::string& nameField ) const;
 
@@ -107,18 +150,52 @@ public:
 	std::optional< double > get_nullable_double( size_t ndxField ) const;
 	std::optional< double > get_nullable_double( const std::string& nameField ) const;
 
+	std::optional< decimal > get_nullable_decimal( size_t ndxField ) const;
+	std::optional< decimal > get_nullable_decimal( const std::string& nameField ) const;
+
 	std::optional< datetime > get_nullable_date( size_t ndxField ) const;
 	std::optional< datetime > get_nullable_date( const std::string& nameField ) const;
 
 	std::optional< datetime > get_nullable_datetime( size_t ndxField ) const;
 	std::optional< datetime > get_nullable_datetime( const std::string& nameField ) const;
 
+	std::optional< time_of_day > get_nullable_time( size_t ndxField ) const;
+	std::optional< time_of_day > get_nullable_time( const std::string& nameField ) const;
+
+	std::optional< interval > get_nullable_interval( size_t ndxField ) const;
+	std::optional< interval > get_nullable_interval( const std::string& nameField ) const;
+
+	std::optional< uuid > get_nullable_uuid( size_t ndxField ) const;
+	std::optional< uuid > get_nullable_uuid( const std::string& nameField ) const;
+
+	std::optional< inet > get_nullable_inet( size_t ndxField ) const;
+	std::optional< inet > get_nullable_inet( const std::string& nameField ) const;
+
+private:
+	// backends with random access read the record's own row, the others their current one
+	template< typename R, typename... A >
+	R read( R ( BE::*get )( A... ) const, size_t ndxField ) const;
+
+	void set_row( size_t row );
+
 private:
 	record_ptr m_impl;
+	size_t m_row { 0 };
+
+	friend class recordset< BE >;
+};
+
+namespace detail
+{
+// returned by the member-wise convert only, tells it apart from the application's overloads
+struct default_convert
+{
 };
+}  // namespace detail
 
+// fills the members in order, overload it to map the fields of a row type otherwise
 template< typename BE, typename T >
-void convert( const record< BE >& from, T& to );
+detail::default_convert convert( const record< BE >& from, T& to );
 
 template< typename T, typename BE >
 inline T convert( const record< BE >& from )
@@ -133,6 +210,33 @@ inline record< BE >::record( record_ptr impl ) : m_impl( impl )
 {
 }
 
+template< typename BE >
+inline record< BE >::record( record_ptr impl, size_t row ) : m_impl( impl ), m_row( row )
+{
+}
+
+template< typename BE >
+inline size_t record< BE >::row( ) const
+{
+	return m_row;
+}
+
+template< typename BE >
+inline void record< BE >::set_row( size_t row )
+{
+	m_row = row;
+}
+
+template< typename BE >
+template< typename R, typename... A >
+inline R record< BE >::read( R ( BE::*get )( A... ) const, size_t ndxField ) const
+{
+	if constexpr( sizeof...( A ) == 2 )
+		return ( m_impl.get( )->*get )( m_row, ndxField );
+	else
+		return ( m_impl.get( )->*get )( ndxField );
+}
+
 template< typename BE >
 inline const fields_type& record< BE >::fields( ) const
 {
@@ -156,7 +260,7 @@ inline size_t record< BE >::field_index( const std::string& nameField ) const
 template< typename BE >
 inline bool record< BE >::is_null( size_t ndxField ) const
 {
-	return m_impl->is_null( ndxField );
+	return read( &BE::is_null, ndxField );
 }
 
 template< typename BE >
@@ -168,25 +272,23 @@ inline bool record< BE >::is_null( const std::string& nameField ) const
 template< typename BE >
 inline std::string record< BE >::get_as_string( size_t ndxField ) const
 {
-	if( fields( )[ ndxField ].db_type( ) == field::type::db_bool )
-		return std::to_string( m_impl->get_bool( ndxField ) );
-	else if( fields( )[ ndxField ].db_type( ) == field::type::db_int8 )
-		return std::to_string( m_impl->get_int8( ndxField ) );
-	else if( fields( )[ ndxField ].db_type( ) == field::type::db_int16 )
-		return std::to_string( m_impl->get_int16( ndxField ) );
-	else if( fields( )[ ndxField ].db_type( ) == field::type::db_int32 )
-		return std::to_string( m_impl->get_int32( ndxField ) );
-	else if( fields( )[ ndxField ].db_type( ) == field::type::db_int64 )
-		return std::to_string( m_impl->get_int64( ndxField ) );
-	else if( fields( )[ ndxField ].db_type( ) == field::type::db_float )
-		return std::to_string( m_impl->get_float( ndxField ) );
-	else if( fields( )[ ndxField ].db_type( ) == field::type::db_double )
-		return std::to_string( m_impl->get_double( ndxField ) );
-	else if( fields( )[ ndxField ].db_type( ) == field::type::db_date )
-		return date::format( "%F", m_impl->get_date( ndxField ) );
-	else if( fields( )[ ndxField ].db_type( ) == field::type::db_datetime )
-		return date::format( "%FT%T", m_impl->get_datetime( ndxField ) );
-	return m_impl->get_string( ndxField );
+	char buffer[ detail::max_datetime_length ];
+	switch( fields( )[ ndxField ].db_type( ) )
+	{
+	case field::type::db_bool: return std::to_string( get_bool( ndxField ) );
+	case field::type::db_int8: return std::to_string( get_int8( ndxField ) );
+	case field::type::db_int16: return std::to_string( get_int16( ndxField ) );
+	case field::type::db_int32: return std::to_string( get_int32( ndxField ) );
+	case field::type::db_int64: return std::to_string( get_int64( ndxField ) );
+	case field::type::db_float: return std::to_string( get_float( ndxField ) );
+	case field::type::db_double: return std::to_string( get_double( ndxField ) );
+	case field::type::db_date:
+		return std::string( buffer, detail::format_date( buffer, get_date( ndxField ) ) );
+	case field::type::db_datetime:
+		return std::string( buffer,
+							detail::format_datetime( buffer, get_datetime( ndxField ) ) );
+	default: return get_string( ndxField );
+	}
 }
 
 template< typename BE >
@@ -198,7 +300,7 @@ inline std::string record< BE >::get_as_string( const std::string& nameField ) c
 template< typename BE >
 inline std::string record< BE >::get_string( size_t ndxField ) const
 {
-	return m_impl->get_string( ndxField );
+	return read( &BE::get_string, ndxField );
 }
 
 template< typename BE >
@@ -207,10 +309,76 @@ inline std::string record< BE >::get_string( const std::string& nameField ) cons
 	return get_string( field_index( nameField ) );
 }
 
+template< typename BE >
+inline std::string_view record< BE >::get_string_view( size_t ndxField ) const
+{
+	return read( &BE::get_string_view, ndxField );
+}
+
+template< typename BE >
+inline std::string_view record< BE >::get_string_view( const std::string& nameField ) const
+{
+	return get_string_view( field_index( nameField ) );
+}
+
+namespace detail
+{
+// backends reading any row of a buffered result instead of only the current one
+template< typename BE, typename = void >
+struct has_row_access : std::false_type
+{
+};
+
+template< typename BE >
+struct has_row_access<
+	BE,
+	std::void_t< decltype( std::declval< const BE& >( ).is_null( size_t( ), size_t( ) ) ) > >
+	: std::true_type
+{
+};
+
+template< typename BE, typename F, typename = void >
+struct has_read_blob : std::false_type
+{
+};
+
+template< typename BE, typename F >
+struct has_read_blob<
+	BE,
+	F,
+	std::void_t< decltype( std::declval< BE& >( ).read_blob( size_t( ), std::declval< F >( ) ) ) > >
+	: std::true_type
+{
+};
+}  // namespace detail
+
+template< typename BE >
+template< typename F >
+inline bool record< BE >::read_blob( size_t ndxField, F&& callback ) const
+{
+	if constexpr( detail::has_read_blob< BE, F >::value )
+		return m_impl->read_blob( ndxField, std::forward< F >( callback ) );
+	else
+	{
+		if( is_null( ndxField ) )
+			return false;
+		const std::string_view value = get_string_view( ndxField );
+		callback( value.data( ), value.size( ) );
+		return true;
+	}
+}
+
+template< typename BE >
+template< typename F >
+inline bool record< BE >::read_blob( const std::string& nameField, F&& callback ) const
+{
+	return read_blob( field_index( nameField ), std::forward< F >( callback ) );
+}
+
 template< typename BE >
 inline bool record< BE >::get_bool( size_t ndxField ) const
 {
-	return m_impl->get_bool( ndxField );
+	return read( &BE::get_bool, ndxField );
 }
 
 template< typename BE >
@@ -222,7 +390,7 @@ inline bool record< BE >::get_bool( const std::string& nameField ) const
 template< typename BE >
 inline int8_t record< BE >::get_int8( size_t ndxField ) const
 {
-	return m_impl->get_int8( ndxField );
+	return read( &BE::get_int8, ndxField );
 }
 
 template< typename BE >
@@ -234,7 +402,7 @@ inline int8_t record< BE >::get_int8( const std::string& nameField ) const
 template< typename BE >
 inline int16_t record< BE >::get_int16( size_t ndxField ) const
 {
-	return m_impl->get_int16( ndxField );
+	return read( &BE::get_int16, ndxField );
 }
 
 template< typename BE >
@@ -246,7 +414,7 @@ inline int16_t record< BE >::get_int16( const std::string& nameField ) const
 template< typename BE >
 inline int32_t record< BE >::get_int32( size_t ndxField ) const
 {
-	return m_impl->get_int32( ndxField );
+	return read( &BE::get_int32, ndxField );
 }
 
 template< typename BE >
@@ -258,7 +426,7 @@ inline int32_t record< BE >::get_int32( const std::string& nameField ) const
 template< typename BE >
 inline int64_t record< BE >::get_int64( size_t ndxField ) const
 {
-	return m_impl->get_int64( ndxField );
+	return read( &BE::get_int64, ndxField );
 }
 
 template< typename BE >
@@ -270,7 +438,7 @@ inline int64_t record< BE >::get_int64( const std::string& nameField ) const
 template< typename BE >
 inline float record< BE >::get_float( size_t ndxField ) const
 {
-	return m_impl->get_float( ndxField );
+	return read( &BE::get_float, ndxField );
 }
 
 template< typename BE >
@@ -282,7 +450,7 @@ inline float record< BE >::get_float( const std::string& nameField ) const
 template< typename BE >
 inline double record< BE >::get_double( size_t ndxField ) const
 {
-	return m_impl->get_double( ndxField );
+	return read( &BE::get_double, ndxField );
 }
 
 template< typename BE >
@@ -291,10 +459,22 @@ inline double record< BE >::get_double( const std::string& nameField ) const
 	return get_double( field_index( nameField ) );
 }
 
+template< typename BE >
+inline decimal record< BE >::get_decimal( size_t ndxField ) const
+{
+	return read( &BE::get_decimal, ndxField );
+}
+
+template< typename BE >
+inline decimal record< BE >::get_decimal( const std::string& nameField ) const
+{
+	return get_decimal( field_index( nameField ) );
+}
+
 template< typename BE >
 inline datetime record< BE >::get_date( size_t ndxField ) const
 {
-	return m_impl->get_date( ndxField );
+	return read( &BE::get_date, ndxField );
 }
 
 template< typename BE >
@@ -306,7 +486,7 @@ inline datetime record< BE >::get_date( const std::string& nameField ) const
 template< typename BE >
 inline datetime record< BE >::get_datetime( size_t ndxField ) const
 {
-	return m_impl->get_datetime( ndxField );
+	return read( &BE::get_datetime, ndxField );
 }
 
 template< typename BE >
@@ -315,6 +495,68 @@ inline datetime record< BE >::get_datetime( const std::string& nameField ) const
 	return get_datetime( field_index( nameField ) );
 }
 
+template< typename BE >
+inline time_of_day record< BE >::get_time( size_t ndxField ) const
+{
+	return read( &BE::get_time, ndxField );
+}
+
+template< typename BE >
+inline time_of_day record< BE >::get_time( const std::string& nameField ) const
+{
+	return get_time( field_index( nameField ) );
+}
+
+template< typename BE >
+inline interval record< BE >::get_interval( size_t ndxField ) const
+{
+	return read( &BE::get_interval, ndxField );
+}
+
+template< typename BE >
+inline interval record< BE >::get_interval( const std::string& nameField ) const
+{
+	return get_interval( field_index( nameField ) );
+}
+
+template< typename BE >
+inline uuid record< BE >::get_uuid( size_t ndxField ) const
+{
+	return read( &BE::get_uuid, ndxField );
+}
+
+template< typename BE >
+inline uuid record< BE >::get_uuid( const std::string& nameField ) const
+{
+	return get_uuid( field_index( nameField ) );
+}
+
+template< typename BE >
+inline inet record< BE >::get_inet( size_t ndxField ) const
+{
+	return read( &BE::get_inet, ndxField );
+}
+
+template< typename BE >
+inline inet record< BE >::get_inet( const std::string& nameField ) const
+{
+	return get_inet( field_index( nameField ) );
+}
+
+template< typename BE >
+template< typename T >
+inline T record< BE >::get_custom( size_t ndxField ) const
+{
+	return read( &BE::template get_custom< T >, ndxField );
+}
+
+template< typename BE >
+template< typename T >
+inline T record< BE >::get_custom( const std::string& nameField ) const
+{
+	return get_custom< T >( field_index( nameField ) );
+}
+
 template< typename BE >
 inline std::optional< std::string > record< BE >::get_nullable_as_string( size_t ndxField ) const
 {
@@ -447,6 +689,21 @@ record< BE >::get_nullable_double( const std::string& nameField ) const
 	return get_nullable_double( field_index( nameField ) );
 }
 
+template< typename BE >
+inline std::optional< decimal > record< BE >::get_nullable_decimal( size_t ndxField ) const
+{
+	if( is_null( ndxField ) )
+		return std::optional< decimal >( );
+	return get_decimal( ndxField );
+}
+
+template< typename BE >
+inline std::optional< decimal >
+record< BE >::get_nullable_decimal( const std::string& nameField ) const
+{
+	return get_nullable_decimal( field_index( nameField ) );
+}
+
 template< typename BE >
 inline std::optional< datetime > record< BE >::get_nullable_date( size_t ndxField ) const
 {
@@ -477,4 +734,64 @@ record< BE >::get_nullable_datetime( const std::string& nameField ) const
 	return get_nullable_datetime( field_index( nameField ) );
 }
 
+template< typename BE >
+inline std::optional< time_of_day > record< BE >::get_nullable_time( size_t ndxField ) const
+{
+	if( is_null( ndxField ) )
+		return std::optional< time_of_day >( );
+	return get_time( ndxField );
+}
+
+template< typename BE >
+inline std::optional< time_of_day >
+record< BE >::get_nullable_time( const std::string& nameField ) const
+{
+	return get_nullable_time( field_index( nameField ) );
+}
+
+template< typename BE >
+inline std::optional< interval > record< BE >::get_nullable_interval( size_t ndxField ) const
+{
+	if( is_null( ndxField ) )
+		return std::optional< interval >( );
+	return get_interval( ndxField );
+}
+
+template< typename BE >
+inline std::optional< interval >
+record< BE >::get_nullable_interval( const std::string& nameField ) const
+{
+	return get_nullable_interval( field_index( nameField ) );
+}
+
+template< typename BE >
+inline std::optional< uuid > record< BE >::get_nullable_uuid( size_t ndxField ) const
+{
+	if( is_null( ndxField ) )
+		return std::optional< uuid >( );
+	return get_uuid( ndxField );
+}
+
+template< typename BE >
+inline std::optional< uuid >
+record< BE >::get_nullable_uuid( const std::string& nameField ) const
+{
+	return get_nullable_uuid( field_index( nameField ) );
+}
+
+template< typename BE >
+inline std::optional< inet > record< BE >::get_nullable_inet( size_t ndxField ) const
+{
+	if( is_null( ndxField ) )
+		return std::optional< inet >( );
+	return get_inet( ndxField );
+}
+
+template< typename BE >
+inline std::optional< inet >
+record< BE >::get_nullable_inet( const std::string& nameField ) const
+{
+	return get_nullable_inet( field_index( nameField ) );
+}
+
 }  // namespace dbclt
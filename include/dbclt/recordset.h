@@ -26,6 +26,9 @@ SOFTWARE.
 
 namespace dbclt
 {
+template< typename BE, typename Row >
+class typed_recordset;
+
 template< typename BE >
 class recordset
 {
@@ -44,6 +47,12 @@ public:
 	template< typename T >
 	T& into( T& container );
 
+	template< typename T >
+	T& into_parallel( T& container, size_t threads = 0 );
+
+	template< typename Row >
+	typed_recordset< BE, Row > as( );
+
 	const fields_type& fields( ) const;
 
 	iterator begin( );
@@ -52,6 +61,22 @@ public:
 	template< typename T >
 	T get( size_t field );
 
+	void write_csv( std::ostream& os, char delimiter = ',', bool header = true );
+	void write_csv( int fd, char delimiter = ',', bool header = true );
+	void write_tsv( std::ostream& os, bool header = true );
+	void write_tsv( int fd, bool header = true );
+	void write_jsonl( std::ostream& os );
+	void write_jsonl( int fd );
+
+	template< typename Sink >
+	void write( text_writer< Sink >& writer, bool header = true );
+
+	void write_arrow( std::ostream& os, size_t batchSize = 64 * 1024 );
+	void write_arrow( int fd, size_t batchSize = 64 * 1024 );
+	void write_arrow( std::vector< char >& buffer, size_t batchSize = 64 * 1024 );
+
+	void save_snapshot( const std::string& path );
+
 public:
 	recordset( recordset_ptr impl );
 
@@ -164,4 +189,145 @@ private:
 	value_type_ptr m_record;
 };
 
+// random access over a fully buffered result, records are handed out by value bound to their row
+template< typename BE >
+class recordset_row_iterator
+{
+public:
+	using recordset_type = recordset< BE >;
+	using backend_type = BE;
+	using iterator_category = std::random_access_iterator_tag;
+	using value_type = typename BE::recordset_value_type;
+	using difference_type = std::ptrdiff_t;
+	using reference = value_type;
+
+	struct pointer
+	{
+		const value_type* operator->( ) const
+		{
+			return &record;
+		}
+
+		value_type record;
+	};
+
+public:
+	recordset_row_iterator( )
+	{
+	}
+
+	recordset_row_iterator( std::shared_ptr< backend_type > impl, size_t row )
+		: m_impl( impl ),
+		  m_row( row )
+	{
+	}
+
+	reference operator*( ) const
+	{
+		return value_type( m_impl, m_row );
+	}
+
+	pointer operator->( ) const
+	{
+		return pointer { value_type( m_impl, m_row ) };
+	}
+
+	reference operator[]( difference_type n ) const
+	{
+		return value_type( m_impl, m_row + n );
+	}
+
+	recordset_row_iterator& operator++( )
+	{
+		++m_row;
+		return *this;
+	}
+
+	recordset_row_iterator operator++( int )
+	{
+		recordset_row_iterator it( *this );
+		++m_row;
+		return it;
+	}
+
+	recordset_row_iterator& operator--( )
+	{
+		--m_row;
+		return *this;
+	}
+
+	recordset_row_iterator operator--( int )
+	{
+		recordset_row_iterator it( *this );
+		--m_row;
+		return it;
+	}
+
+	recordset_row_iterator& operator+=( difference_type n )
+	{
+		m_row += n;
+		return *this;
+	}
+
+	recordset_row_iterator& operator-=( difference_type n )
+	{
+		m_row -= n;
+		return *this;
+	}
+
+	recordset_row_iterator operator+( difference_type n ) const
+	{
+		return recordset_row_iterator( m_impl, m_row + n );
+	}
+
+	friend recordset_row_iterator operator+( difference_type n, const recordset_row_iterator& it )
+	{
+		return it + n;
+	}
+
+	recordset_row_iterator operator-( difference_type n ) const
+	{
+		return recordset_row_iterator( m_impl, m_row - n );
+	}
+
+	difference_type operator-( const recordset_row_iterator& other ) const
+	{
+		return ( difference_type )m_row - ( difference_type )other.m_row;
+	}
+
+	bool operator==( const recordset_row_iterator& other ) const
+	{
+		return m_row == other.m_row;
+	}
+
+	bool operator!=( const recordset_row_iterator& other ) const
+	{
+		return m_row != other.m_row;
+	}
+
+	bool operator<( const recordset_row_iterator& other ) const
+	{
+		return m_row < other.m_row;
+	}
+
+	bool operator>( const recordset_row_iterator& other ) const
+	{
+		return m_row > other.m_row;
+	}
+
+	bool operator<=( const recordset_row_iterator& other ) const
+	{
+		return m_row <= other.m_row;
+	}
+
+	bool operator>=( const recordset_row_iterator& other ) const
+	{
+		return m_row >= other.m_row;
+	}
+
+private:
+	std::shared_ptr< backend_type > m_impl;
+	size_t m_row { 0 };
+};
+
 }  // namespace dbclt
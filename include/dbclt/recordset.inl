@@ -30,10 +30,14 @@ namespace dbclt
 {
 namespace detail
 {
+// types without a getter of their own are left to the backend's codecs
 template< typename BE, typename T >
 struct get_value
 {
-	T operator( )( const dbclt::record< BE >& from, size_t ndx );
+	T operator( )( const dbclt::record< BE >& from, size_t ndx )
+	{
+		return from.template get_custom< T >( ndx );
+	}
 };
 
 template< typename BE >
@@ -126,6 +130,15 @@ struct get_value< BE, double >
 	}
 };
 
+template< typename BE >
+struct get_value< BE, dbclt::decimal >
+{
+	dbclt::decimal operator( )( const dbclt::record< BE >& from, size_t ndx )
+	{
+		return from.get_decimal( ndx );
+	}
+};
+
 template< typename BE >
 struct get_value< BE, bool >
 {
@@ -144,6 +157,52 @@ struct get_value< BE, dbclt::datetime >
 	}
 };
 
+template< typename BE >
+struct get_value< BE, dbclt::time_of_day >
+{
+	dbclt::time_of_day operator( )( const dbclt::record< BE >& from, size_t ndx )
+	{
+		return from.get_time( ndx );
+	}
+};
+
+template< typename BE >
+struct get_value< BE, dbclt::interval >
+{
+	dbclt::interval operator( )( const dbclt::record< BE >& from, size_t ndx )
+	{
+		return from.get_interval( ndx );
+	}
+};
+
+template< typename BE >
+struct get_value< BE, dbclt::uuid >
+{
+	dbclt::uuid operator( )( const dbclt::record< BE >& from, size_t ndx )
+	{
+		return from.get_uuid( ndx );
+	}
+};
+
+template< typename BE >
+struct get_value< BE, dbclt::inet >
+{
+	dbclt::inet operator( )( const dbclt::record< BE >& from, size_t ndx )
+	{
+		return from.get_inet( ndx );
+	}
+};
+
+template< typename BE >
+struct get_value< BE, std::vector< uint8_t > >
+{
+	std::vector< uint8_t > operator( )( const dbclt::record< BE >& from, size_t ndx )
+	{
+		const std::string_view value = from.get_string_view( ndx );
+		return std::vector< uint8_t >( value.begin( ), value.end( ) );
+	}
+};
+
 template< typename BE, typename T >
 struct get_value< BE, std::optional< T > >
 {
@@ -155,6 +214,28 @@ struct get_value< BE, std::optional< T > >
 	}
 };
 
+template< typename BE, typename T, typename = void >
+struct has_bulk_into : std::false_type
+{
+};
+
+template< typename BE, typename T >
+struct has_bulk_into< BE,
+					  T,
+					  std::void_t< decltype( std::declval< BE& >( ).bulk_into(
+						  std::declval< T& >( ) ) ) > > : std::true_type
+{
+};
+
+// an overload of convert( ) for the row type is found by adl where the row is converted
+template< typename BE, typename T >
+struct has_default_convert
+	: std::is_same< decltype( convert( std::declval< const dbclt::record< BE >& >( ),
+									   std::declval< T& >( ) ) ),
+					default_convert >
+{
+};
+
 template< typename BE, typename T, typename Tup, std::size_t... I >
 T convert( const dbclt::record< BE >& from, std::index_sequence< I... > )
 {
@@ -163,11 +244,12 @@ T convert( const dbclt::record< BE >& from, std::index_sequence< I... > )
 }  // namespace detail
 
 template< typename BE, typename T >
-void dbclt::convert( const dbclt::record< BE >& from, T& to )
+dbclt::detail::default_convert dbclt::convert( const dbclt::record< BE >& from, T& to )
 {
 	using Tup = decltype( structs::to_tuple( to ) );
 	to = detail::convert< BE, T, Tup >( from,
 										std::make_index_sequence< std::tuple_size_v< Tup > > { } );
+	return detail::default_convert( );
 }
 
 template< typename BE >
@@ -200,6 +282,15 @@ template< typename BE >
 template< typename T >
 inline T& recordset< BE >::into( T& container )
 {
+	// backends able to fetch into the rows directly skip the per record conversion, unless the
+	// row type has its own convert( )
+	if constexpr( detail::has_bulk_into< BE, T >::value &&
+				  detail::has_default_convert< BE, typename T::value_type >::value )
+	{
+		if( m_begin != m_end && m_impl->bulk_into( container ) )
+			return container;
+	}
+
 	for( const typename BE::recordset_value_type& rec: *this )
 	{
 		typename T::value_type converted;
@@ -210,12 +301,175 @@ inline T& recordset< BE >::into( T& container )
 	return container;
 }
 
+template< typename BE >
+template< typename T >
+inline T& recordset< BE >::into_parallel( T& container, size_t threads )
+{
+	// streaming backends only expose the current row
+	if constexpr( !detail::has_row_access< BE >::value )
+		return into( container );
+	else
+	{
+		static constexpr size_t minRowsPerThread = 1024;
+
+		const size_t rows = record_count( );
+		if( !threads )
+			threads = std::max( std::thread::hardware_concurrency( ), 1u );
+		threads = std::max( std::min( threads, rows / minRowsPerThread ), size_t( 1 ) );
+
+		const size_t offset = container.size( );
+		container.resize( offset + rows );
+
+		// each thread walks a disjoint range of rows with its own record
+		auto worker = [ this, &container, offset ]( size_t first, size_t last ) {
+			record_type rec( m_impl, first );
+			for( size_t row = first; row < last; ++row )
+			{
+				rec.set_row( row );
+				convert( rec, container[ offset + row ] );
+			}
+		};
+
+		std::exception_ptr error;
+		std::mutex errorLock;
+		std::vector< std::thread > workers;
+		workers.reserve( threads - 1 );
+
+		const size_t chunk = ( rows + threads - 1 ) / threads;
+		for( size_t first = chunk; first < rows; first += chunk )
+			workers.emplace_back( [ &, first ]( ) {
+				try
+				{
+					worker( first, std::min( first + chunk, rows ) );
+				}
+				catch( ... )
+				{
+					std::lock_guard< std::mutex > lock( errorLock );
+					if( !error )
+						error = std::current_exception( );
+				}
+			} );
+
+		try
+		{
+			worker( 0, std::min( chunk, rows ) );
+		}
+		catch( ... )
+		{
+			std::lock_guard< std::mutex > lock( errorLock );
+			if( !error )
+				error = std::current_exception( );
+		}
+
+		for( std::thread& t: workers )
+			t.join( );
+
+		if( error )
+		{
+			container.resize( offset );
+			std::rethrow_exception( error );
+		}
+		return container;
+	}
+}
+
+template< typename BE >
+template< typename Row >
+inline typed_recordset< BE, Row > recordset< BE >::as( )
+{
+	return typed_recordset< BE, Row >( m_impl );
+}
+
 template< typename BE >
 inline const fields_type& recordset< BE >::fields( ) const
 {
 	return m_impl->record_fields( );
 }
 
+template< typename BE >
+template< typename Sink >
+inline void recordset< BE >::write( text_writer< Sink >& writer, bool header )
+{
+	if( header )
+		writer.header( fields( ) );
+	for( const typename BE::recordset_value_type& rec: *this )
+		writer.write( rec );
+	writer.flush( );
+}
+
+template< typename BE >
+inline void recordset< BE >::write_csv( std::ostream& os, char delimiter, bool header )
+{
+	text_writer< ostream_sink > writer( os, text_format::csv, delimiter );
+	write( writer, header );
+}
+
+template< typename BE >
+inline void recordset< BE >::write_csv( int fd, char delimiter, bool header )
+{
+	text_writer< fd_sink > writer( fd, text_format::csv, delimiter );
+	write( writer, header );
+}
+
+template< typename BE >
+inline void recordset< BE >::write_tsv( std::ostream& os, bool header )
+{
+	text_writer< ostream_sink > writer( os, text_format::tsv );
+	write( writer, header );
+}
+
+template< typename BE >
+inline void recordset< BE >::write_tsv( int fd, bool header )
+{
+	text_writer< fd_sink > writer( fd, text_format::tsv );
+	write( writer, header );
+}
+
+template< typename BE >
+inline void recordset< BE >::write_jsonl( std::ostream& os )
+{
+	text_writer< ostream_sink > writer( os, text_format::jsonl );
+	write( writer, false );
+}
+
+template< typename BE >
+inline void recordset< BE >::write_jsonl( int fd )
+{
+	text_writer< fd_sink > writer( fd, text_format::jsonl );
+	write( writer, false );
+}
+
+template< typename BE >
+inline void recordset< BE >::write_arrow( std::ostream& os, size_t batchSize )
+{
+	arrow_writer< ostream_sink > writer( os, batchSize );
+	writer.write( *this );
+	writer.close( );
+}
+
+template< typename BE >
+inline void recordset< BE >::write_arrow( int fd, size_t batchSize )
+{
+	arrow_writer< fd_sink > writer( fd, batchSize );
+	writer.write( *this );
+	writer.close( );
+}
+
+template< typename BE >
+inline void recordset< BE >::write_arrow( std::vector< char >& buffer, size_t batchSize )
+{
+	arrow_writer< memory_sink > writer( buffer, batchSize );
+	writer.write( *this );
+	writer.close( );
+}
+
+template< typename BE >
+inline void recordset< BE >::save_snapshot( const std::string& path )
+{
+	snapshot_writer writer( path );
+	writer.write( *this );
+}
+
 template< typename BE >
 inline typename recordset< BE >::iterator recordset< BE >::begin( )
 {
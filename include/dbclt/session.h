@@ -57,6 +57,10 @@ public:
 	template< typename... col_types >
 	recordset_type query_params( const std::string& stmt, col_types&&... values );
 
+	template< typename Row, typename... col_types >
+	typed_recordset< typename recordset_type::backend_type, Row >
+	query_as( const std::string& stmt, col_types&&... values );
+
 	template< typename T >
 	void bulk_insert( const std::string& table, const T& container );
 
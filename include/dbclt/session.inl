@@ -26,6 +26,24 @@ SOFTWARE.
 
 namespace dbclt
 {
+namespace detail
+{
+template< typename BE, typename T, typename = void >
+struct has_bulk_insert : std::false_type
+{
+};
+
+template< typename BE, typename T >
+struct has_bulk_insert<
+	BE,
+	T,
+	std::void_t< decltype( std::declval< BE& >( ).bulk_insert(
+		std::declval< const std::string& >( ), std::declval< const T& >( ) ) ) > >
+	: std::true_type
+{
+};
+}  // namespace detail
+
 template< typename BE >
 inline session< BE >::session( ) : m_session( std::make_shared< BE >( ) )
 {
@@ -107,10 +125,23 @@ inline typename session< BE >::recordset_type session< BE >::query_params( const
 	return st.query_params( stmt, std::forward< col_types >( values )... );
 }
 
+template< typename BE >
+template< typename Row, typename... col_types >
+inline typed_recordset< typename session< BE >::recordset_type::backend_type, Row >
+session< BE >::query_as( const std::string& stmt, col_types&&... values )
+{
+	if constexpr( sizeof...( col_types ) == 0 )
+		return query( stmt ).template as< Row >( );
+	else
+		return query_params( stmt, std::forward< col_types >( values )... ).template as< Row >( );
+}
+
 template< typename BE >
 template< typename T >
 inline void session< BE >::bulk_insert( const std::string& table, const T& container )
 {
+	if constexpr( detail::has_bulk_insert< BE, T >::value )
+		m_session->bulk_insert( table, container );
 }
 
 template< typename BE >
@@ -0,0 +1,80 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <date/date.h>
+#include <iterator>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string.h>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#ifdef WIN32
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+#include "data_exception.h"
+#include "field.h"
+#include "range.h"
+#include "util.h"
+#include "writer.h"
+
+#include "record.h"
+#include "recordset.h"
+#include "result.h"
+#include "typed_recordset.h"
+
+#include "session.h"
+#include "statement.h"
+#include "transaction.h"
+
+#include "arrow.h"
+#include "snapshot_writer.h"
+
+#include "snapshot/common.h"
+#include "snapshot/result.h"
+
+#include "snapshot/result.inl"
+
+#include "recordset.inl"
+#include "result.inl"
+#include "session.inl"
+#include "statement.inl"
+#include "transaction.inl"
+#include "typed_recordset.inl"
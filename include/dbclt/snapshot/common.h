@@ -0,0 +1,123 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+namespace dbclt
+{
+namespace snapshot
+{
+class mapped_file
+{
+public:
+	mapped_file( const std::string& path );
+	~mapped_file( );
+
+	const uint8_t* data( ) const;
+	size_t size( ) const;
+
+private:
+	const uint8_t* m_data { nullptr };
+	size_t m_size { 0 };
+
+private:
+	mapped_file( const mapped_file& ) = delete;
+	mapped_file& operator=( const mapped_file& ) = delete;
+};
+
+using mapped_file_ptr = std::shared_ptr< mapped_file >;
+
+#ifdef WIN32
+inline mapped_file::mapped_file( const std::string& path )
+{
+	HANDLE file = CreateFileA( path.c_str( ),
+							   GENERIC_READ,
+							   FILE_SHARE_READ | FILE_SHARE_DELETE,
+							   nullptr,
+							   OPEN_EXISTING,
+							   FILE_ATTRIBUTE_NORMAL,
+							   nullptr );
+	if( file == INVALID_HANDLE_VALUE )
+		throw data_exception( "Cannot open snapshot: " + path );
+
+	LARGE_INTEGER size;
+	HANDLE mapping = nullptr;
+	if( GetFileSizeEx( file, &size ) && size.QuadPart > 0 )
+		mapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+	CloseHandle( file );
+	if( mapping == nullptr )
+		throw data_exception( "Cannot map snapshot: " + path );
+
+	m_data = ( const uint8_t* )MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+	CloseHandle( mapping );
+	if( m_data == nullptr )
+		throw data_exception( "Cannot map snapshot: " + path );
+	m_size = ( size_t )size.QuadPart;
+}
+
+inline mapped_file::~mapped_file( )
+{
+	UnmapViewOfFile( m_data );
+}
+#else
+inline mapped_file::mapped_file( const std::string& path )
+{
+	const int fd = ::open( path.c_str( ), O_RDONLY );
+	if( fd < 0 )
+		throw data_exception( "Cannot open snapshot: " + path + " -- " + strerror( errno ) );
+
+	struct stat st;
+	if( fstat( fd, &st ) < 0 || st.st_size == 0 )
+	{
+		::close( fd );
+		throw data_exception( "Cannot map snapshot: " + path );
+	}
+
+	void* data = mmap( nullptr, ( size_t )st.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+	::close( fd );
+	if( data == MAP_FAILED )
+		throw data_exception( "Cannot map snapshot: " + path + " -- " + strerror( errno ) );
+
+	m_data = ( const uint8_t* )data;
+	m_size = ( size_t )st.st_size;
+}
+
+inline mapped_file::~mapped_file( )
+{
+	munmap( ( void* )m_data, m_size );
+}
+#endif
+
+inline const uint8_t* mapped_file::data( ) const
+{
+	return m_data;
+}
+
+inline size_t mapped_file::size( ) const
+{
+	return m_size;
+}
+
+}  // namespace snapshot
+}  // namespace dbclt
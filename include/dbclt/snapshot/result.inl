@@ -0,0 +1,265 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+namespace dbclt
+{
+namespace snapshot
+{
+inline recordset open( const std::string& path )
+{
+	result res( result_impl::create( std::make_shared< mapped_file >( path ) ) );
+	return *res.recordsets( ).begin( );
+}
+
+inline std::shared_ptr< result_impl > result_impl::create( mapped_file_ptr file )
+{
+	std::shared_ptr< result_impl > ptr( std::make_shared< result_impl >( ) );
+	ptr->init( file );
+	return ptr;
+}
+
+inline void result_impl::init( mapped_file_ptr file )
+{
+	const uint8_t* base = file->data( );
+	const size_t size = file->size( );
+
+	detail::snapshot_header header;
+	if( size < sizeof( header ) )
+		throw data_exception( "Invalid snapshot: truncated header" );
+	memcpy( &header, base, sizeof( header ) );
+	if( memcmp( header.magic, detail::snapshot_magic, sizeof( header.magic ) ) != 0 )
+		throw data_exception( "Invalid snapshot: bad magic" );
+	if( header.version != detail::snapshot_version )
+		throw data_exception( "Unsupported snapshot version: " + std::to_string( header.version ) );
+	if( header.size != size ||
+		sizeof( header ) + header.fields * sizeof( detail::snapshot_column ) > size )
+		throw data_exception( "Invalid snapshot: truncated file" );
+
+	auto check = [ & ]( uint64_t offset, uint64_t length ) {
+		if( offset > size || length > size - offset )
+			throw data_exception( "Invalid snapshot: section out of bounds" );
+	};
+
+	const detail::snapshot_column* columns =
+		( const detail::snapshot_column* )( base + sizeof( header ) );
+	m_fields.resize( header.fields );
+	m_columns.resize( header.fields );
+	for( size_t i = 0; i < header.fields; ++i )
+	{
+		const detail::snapshot_column& col = columns[ i ];
+		const field::type type = ( field::type )col.type;
+		const size_t valueSize = detail::snapshot_value_size( type );
+
+		check( col.nameOffset, col.nameLength );
+		check( col.validityOffset,
+			   col.validityOffset ? header.records / 8 + ( header.records % 8 != 0 ) : 0 );
+		check( col.valuesOffset, col.valuesLength );
+		if( valueSize == 0 )
+		{
+			if( header.records >= size / sizeof( uint64_t ) ||
+				col.offsetsOffset % sizeof( uint64_t ) != 0 )
+				throw data_exception( "Invalid snapshot: bad offsets" );
+			check( col.offsetsOffset, ( header.records + 1 ) * sizeof( uint64_t ) );
+
+			// every value holds at least its null terminator and ends within the values
+			const uint64_t* offsets = ( const uint64_t* )( base + col.offsetsOffset );
+			for( uint64_t r = 0; r < header.records; ++r )
+				if( offsets[ r + 1 ] <= offsets[ r ] )
+					throw data_exception( "Invalid snapshot: bad offsets" );
+			if( offsets[ header.records ] > col.valuesLength )
+				throw data_exception( "Invalid snapshot: bad offsets" );
+		}
+		else if( header.records > size / valueSize ||
+				 col.valuesLength != header.records * valueSize ||
+				 col.valuesOffset % valueSize != 0 )
+			throw data_exception( "Invalid snapshot: bad column length" );
+
+		m_fields[ i ] =
+			field( std::string( ( const char* )base + col.nameOffset, col.nameLength ), type );
+		column& dest = m_columns[ i ];
+		dest.type = type;
+		dest.validity = col.validityOffset ? base + col.validityOffset : nullptr;
+		dest.offsets = valueSize == 0 ? ( const uint64_t* )( base + col.offsetsOffset ) : nullptr;
+		dest.values = base + col.valuesOffset;
+	}
+
+	m_records = header.records;
+	m_file = file;
+}
+
+inline size_t result_impl::affected_count( ) const
+{
+	return 0;
+}
+
+inline int result_impl::return_value( ) const
+{
+	return 0;
+}
+
+inline size_t result_impl::record_count( ) const
+{
+	return m_records;
+}
+
+inline const fields_type& result_impl::record_fields( ) const
+{
+	return m_fields;
+}
+
+inline result_impl::recordset_value_type* result_impl::create_record( )
+{
+	return new recordset_value_type( shared_from_this( ) );
+}
+
+inline result_impl::recordset_iterator
+result_impl::begin( std::shared_ptr< recordset_value_type > /*record*/ )
+{
+	return recordset_iterator( shared_from_this( ), 0 );
+}
+
+inline result_impl::recordset_iterator result_impl::end( )
+{
+	return recordset_iterator( shared_from_this( ), m_records );
+}
+
+inline result_impl::recordset_type result_impl::create_recordset( )
+{
+	return recordset_type( shared_from_this( ) );
+}
+
+inline result_impl::recordsets_type result_impl::create_recordsets( recordset_type& firstRecordset )
+{
+	return recordsets_type( recordsets_iterator( this, &firstRecordset ),
+							recordsets_iterator( this, nullptr ) );
+}
+
+inline void result_impl::next_recordset( recordsets_value_type*& data )
+{
+	data = nullptr;
+}
+
+inline result_impl::recordsets_value_type& result_impl::get_recordset( recordsets_value_type* data )
+{
+	return *data;
+}
+
+inline const result_impl::column& result_impl::data( size_t field ) const
+{
+	if( field >= m_columns.size( ) )
+		throw data_exception( "Invalid field index" );
+	return m_columns[ field ];
+}
+
+template< typename T >
+inline T result_impl::get_value( size_t row, size_t field ) const
+{
+	const column& col = data( field );
+	switch( col.type )
+	{
+	case field::type::db_bool:
+	case field::type::db_int8: return ( T )( ( const int8_t* )col.values )[ row ];
+	case field::type::db_int16: return ( T )( ( const int16_t* )col.values )[ row ];
+	case field::type::db_int32: return ( T )( ( const int32_t* )col.values )[ row ];
+	case field::type::db_int64:
+	case field::type::db_date:
+	case field::type::db_datetime: return ( T )( ( const int64_t* )col.values )[ row ];
+	case field::type::db_float: return ( T )( ( const float* )col.values )[ row ];
+	case field::type::db_double: return ( T )( ( const double* )col.values )[ row ];
+	default: throw data_exception( "Invalid field type for field: " + std::to_string( field ) );
+	}
+}
+
+inline bool result_impl::is_null( size_t row, size_t field ) const
+{
+	const column& col = data( field );
+	return col.validity && ( col.validity[ row / 8 ] & ( 1 << ( row % 8 ) ) ) == 0;
+}
+
+inline std::string result_impl::get_string( size_t row, size_t field ) const
+{
+	return std::string( get_string_view( row, field ) );
+}
+
+inline std::string_view result_impl::get_string_view( size_t row, size_t field ) const
+{
+	const column& col = data( field );
+	if( col.offsets == nullptr )
+		throw data_exception( "Invalid field type for field: " + std::to_string( field ) );
+
+	// every value is stored with its null terminator
+	const uint64_t begin = col.offsets[ row ];
+	const uint64_t end = col.offsets[ row + 1 ];
+	return std::string_view( ( const char* )col.values + begin, end - begin - 1 );
+}
+
+inline bool result_impl::get_bool( size_t row, size_t field ) const
+{
+	return get_value< int64_t >( row, field ) != 0;
+}
+
+inline int8_t result_impl::get_int8( size_t row, size_t field ) const
+{
+	return get_value< int8_t >( row, field );
+}
+
+inline int16_t result_impl::get_int16( size_t row, size_t field ) const
+{
+	return get_value< int16_t >( row, field );
+}
+
+inline int32_t result_impl::get_int32( size_t row, size_t field ) const
+{
+	return get_value< int32_t >( row, field );
+}
+
+inline int64_t result_impl::get_int64( size_t row, size_t field ) const
+{
+	return get_value< int64_t >( row, field );
+}
+
+inline float result_impl::get_float( size_t row, size_t field ) const
+{
+	return get_value< float >( row, field );
+}
+
+inline double result_impl::get_double( size_t row, size_t field ) const
+{
+	return get_value< double >( row, field );
+}
+
+inline datetime result_impl::get_date( size_t row, size_t field ) const
+{
+	return datetime( std::chrono::microseconds( get_value< int64_t >( row, field ) ) );
+}
+
+inline datetime result_impl::get_datetime( size_t row, size_t field ) const
+{
+	return datetime( std::chrono::microseconds( get_value< int64_t >( row, field ) ) );
+}
+
+}  // namespace snapshot
+}  // namespace dbclt
@@ -0,0 +1,292 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+
+namespace dbclt
+{
+namespace detail
+{
+struct snapshot_header
+{
+	char magic[ 8 ];
+	uint32_t version;
+	uint32_t fields;
+	uint64_t records;
+	uint64_t size;
+};
+
+struct snapshot_column
+{
+	uint32_t type;
+	uint32_t nameLength;
+	uint64_t nameOffset;
+	uint64_t validityOffset;
+	uint64_t offsetsOffset;
+	uint64_t valuesOffset;
+	uint64_t valuesLength;
+};
+
+constexpr char snapshot_magic[ 8 ] = { 'D', 'B', 'C', 'L', 'T', 'S', 'N', 'P' };
+constexpr uint32_t snapshot_version = 1;
+constexpr size_t snapshot_alignment = 64;
+
+size_t snapshot_value_size( field::type type );
+
+}  // namespace detail
+
+class snapshot_writer
+{
+public:
+	snapshot_writer( const std::string& path );
+
+	template< typename BE >
+	void write( recordset< BE >& rs );
+
+private:
+	struct column
+	{
+		field::type type;
+		size_t nulls { 0 };
+		detail::aligned_buffer validity;
+		detail::aligned_buffer offsets;
+		detail::aligned_buffer values;
+	};
+
+	template< typename R >
+	void append( const R& record );
+
+	void save( const fields_type& fields );
+
+private:
+	std::string m_path;
+	std::vector< std::unique_ptr< column > > m_columns;
+	uint64_t m_records { 0 };
+};
+
+namespace detail
+{
+inline size_t snapshot_value_size( field::type type )
+{
+	switch( type )
+	{
+	case field::type::db_bool:
+	case field::type::db_int8: return 1;
+	case field::type::db_int16: return 2;
+	case field::type::db_int32:
+	case field::type::db_float: return 4;
+	case field::type::db_int64:
+	case field::type::db_double:
+	case field::type::db_date:
+	case field::type::db_datetime: return 8;
+	default: return 0;
+	}
+}
+
+}  // namespace detail
+
+inline snapshot_writer::snapshot_writer( const std::string& path ) : m_path( path )
+{
+}
+
+template< typename BE >
+inline void snapshot_writer::write( recordset< BE >& rs )
+{
+	m_columns.clear( );
+	m_records = 0;
+	for( const field& fld: rs.fields( ) )
+	{
+		m_columns.emplace_back( new column( ) );
+		m_columns.back( )->type = fld.db_type( );
+		if( detail::snapshot_value_size( fld.db_type( ) ) == 0 )
+			m_columns.back( )->offsets.push_back( ( uint64_t )0 );
+	}
+
+	for( const typename BE::recordset_value_type& rec: rs )
+	{
+		append( rec );
+		++m_records;
+	}
+
+	save( rs.fields( ) );
+}
+
+template< typename R >
+inline void snapshot_writer::append( const R& record )
+{
+	for( size_t i = 0; i < m_columns.size( ); ++i )
+	{
+		column& col = *m_columns[ i ];
+		const bool isNull = record.is_null( i );
+		col.validity.push_bit( !isNull );
+		col.nulls += isNull;
+
+		switch( col.type )
+		{
+		case field::type::db_bool:
+			col.values.push_back( ( int8_t )( !isNull && record.get_bool( i ) ) );
+			break;
+		case field::type::db_int8:
+			col.values.push_back( isNull ? 0 : record.get_int8( i ) );
+			break;
+		case field::type::db_int16:
+			col.values.push_back( isNull ? 0 : record.get_int16( i ) );
+			break;
+		case field::type::db_int32:
+			col.values.push_back( isNull ? 0 : record.get_int32( i ) );
+			break;
+		case field::type::db_int64:
+			col.values.push_back( isNull ? 0 : record.get_int64( i ) );
+			break;
+		case field::type::db_float:
+			col.values.push_back( isNull ? 0 : record.get_float( i ) );
+			break;
+		case field::type::db_double:
+			col.values.push_back( isNull ? 0 : record.get_double( i ) );
+			break;
+		case field::type::db_date:
+			col.values.push_back(
+				( int64_t )( isNull ? 0 : record.get_date( i ).time_since_epoch( ).count( ) ) );
+			break;
+		case field::type::db_datetime:
+			col.values.push_back(
+				( int64_t )( isNull ? 0 : record.get_datetime( i ).time_since_epoch( ).count( ) ) );
+			break;
+		default:
+			if( !isNull && detail::is_formatted( col.type ) )
+			{
+				const std::string value = record.get_string( i );
+				col.values.append( value.data( ), value.size( ) );
+			}
+			else if( !isNull )
+			{
+				const std::string_view value = record.get_string_view( i );
+				col.values.append( value.data( ), value.size( ) );
+			}
+			// values are null terminated so they can be handed out in place
+			col.values.push_back( '\0' );
+			col.offsets.push_back( ( uint64_t )col.values.size( ) );
+		}
+	}
+}
+
+inline void snapshot_writer::save( const fields_type& fields )
+{
+	constexpr size_t alignment = detail::snapshot_alignment;
+	auto align = [ & ]( uint64_t pos ) { return ( pos + alignment - 1 ) / alignment * alignment; };
+
+	detail::snapshot_header header;
+	memcpy( header.magic, detail::snapshot_magic, sizeof( header.magic ) );
+	header.version = detail::snapshot_version;
+	header.fields = ( uint32_t )fields.size( );
+	header.records = m_records;
+
+	// layout: header, column directory, names, then every column section 64 bytes aligned
+	std::vector< detail::snapshot_column > columns( fields.size( ) );
+	uint64_t pos = sizeof( header ) + columns.size( ) * sizeof( detail::snapshot_column );
+	for( size_t i = 0; i < fields.size( ); ++i )
+	{
+		columns[ i ].type = ( uint32_t )fields[ i ].db_type( );
+		columns[ i ].nameLength = ( uint32_t )fields[ i ].name( ).size( );
+		columns[ i ].nameOffset = pos;
+		pos += fields[ i ].name( ).size( ) + 1;
+	}
+
+	for( size_t i = 0; i < m_columns.size( ); ++i )
+	{
+		column& col = *m_columns[ i ];
+		columns[ i ].validityOffset = 0;
+		if( col.nulls > 0 )
+		{
+			columns[ i ].validityOffset = pos = align( pos );
+			pos += col.validity.size( );
+		}
+
+		columns[ i ].offsetsOffset = 0;
+		if( col.offsets.size( ) > 0 )
+		{
+			columns[ i ].offsetsOffset = pos = align( pos );
+			pos += col.offsets.size( );
+		}
+
+		columns[ i ].valuesOffset = pos = align( pos );
+		columns[ i ].valuesLength = col.values.size( );
+		pos += col.values.size( );
+	}
+	header.size = pos;
+
+	// write next to the target and rename, readers never see a partial snapshot
+	const std::string tmpPath = m_path + ".tmp";
+	{
+		std::ofstream os( tmpPath, std::ios::binary | std::ios::trunc );
+		if( !os )
+			throw data_exception( "Cannot create snapshot: " + tmpPath );
+
+		uint64_t written = 0;
+		auto write = [ & ]( const void* data, size_t size ) {
+			os.write( ( const char* )data, ( std::streamsize )size );
+			written += size;
+		};
+		auto pad = [ & ]( uint64_t to ) {
+			static const char zeros[ alignment ] = { };
+			write( zeros, to - written );
+		};
+
+		write( &header, sizeof( header ) );
+		write( columns.data( ), columns.size( ) * sizeof( detail::snapshot_column ) );
+		for( const field& fld: fields )
+			write( fld.name( ).c_str( ), fld.name( ).size( ) + 1 );
+
+		for( size_t i = 0; i < m_columns.size( ); ++i )
+		{
+			column& col = *m_columns[ i ];
+			if( columns[ i ].validityOffset != 0 )
+			{
+				pad( columns[ i ].validityOffset );
+				write( col.validity.data( ), col.validity.size( ) );
+			}
+			if( columns[ i ].offsetsOffset != 0 )
+			{
+				pad( columns[ i ].offsetsOffset );
+				write( col.offsets.data( ), col.offsets.size( ) );
+			}
+			pad( columns[ i ].valuesOffset );
+			write( col.values.data( ), col.values.size( ) );
+		}
+
+		os.close( );
+		if( !os )
+			throw data_exception( "Cannot write snapshot: " + tmpPath );
+	}
+
+	std::error_code ec;
+	std::filesystem::rename( tmpPath, m_path, ec );
+	if( ec )
+		throw data_exception( "Cannot save snapshot: " + m_path + " -- " + ec.message( ) );
+}
+
+}  // namespace dbclt
@@ -0,0 +1,80 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <date/date.h>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string.h>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "data_exception.h"
+#include "field.h"
+#include "range.h"
+#include "util.h"
+#include "writer.h"
+
+#include "record.h"
+#include "recordset.h"
+#include "result.h"
+#include "typed_recordset.h"
+
+#include "session.h"
+#include "statement.h"
+#include "transaction.h"
+#include "executor.h"
+
+#include "arrow.h"
+#include "snapshot_writer.h"
+
+#include "sqlite/common.h"
+#include "sqlite/result.h"
+#include "sqlite/session.h"
+#include "sqlite/statement.h"
+
+#include "sqlite/result.inl"
+#include "sqlite/session.inl"
+#include "sqlite/statement.inl"
+
+#include "executor.inl"
+#include "recordset.inl"
+#include "result.inl"
+#include "session.inl"
+#include "statement.inl"
+#include "transaction.inl"
+#include "typed_recordset.inl"
@@ -0,0 +1,182 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <sqlite3.h>
+
+namespace dbclt
+{
+namespace sqlite
+{
+class conn_ptr : public std::shared_ptr< sqlite3 >
+{
+public:
+	conn_ptr( )
+	{
+	}
+	conn_ptr( sqlite3* conn ) : std::shared_ptr< sqlite3 >( conn, sqlite3_close_v2 )
+	{
+	}
+};
+
+class stmt_ptr : public std::shared_ptr< sqlite3_stmt >
+{
+public:
+	stmt_ptr( )
+	{
+	}
+	stmt_ptr( sqlite3_stmt* stmt ) : std::shared_ptr< sqlite3_stmt >( stmt, sqlite3_finalize )
+	{
+	}
+};
+
+namespace detail
+{
+// stored as text the way sqlite's own date functions print it, 'YYYY-MM-DD HH:MM:SS.ffffff'
+inline std::string format_datetime( const datetime& value )
+{
+	char buffer[ dbclt::detail::max_datetime_length ];
+	char* end = dbclt::detail::format_datetime( buffer, value );
+	std::replace( buffer, end, 'T', ' ' );
+	return std::string( buffer, end );
+}
+
+// accepts 'YYYY-MM-DD[( |T)HH:MM[:SS[.fff]]][Z|(+|-)HH:MM]'
+inline bool parse_datetime( const char* text, size_t size, datetime& value )
+{
+	const char* p = text;
+	const char* end = text + size;
+	auto number = [ & ]( size_t digits, int& out ) {
+		out = 0;
+		for( size_t i = 0; i < digits; ++i, ++p )
+		{
+			if( p == end || *p < '0' || *p > '9' )
+				return false;
+			out = out * 10 + ( *p - '0' );
+		}
+		return true;
+	};
+	auto skip = [ & ]( char c ) {
+		if( p == end || *p != c )
+			return false;
+		++p;
+		return true;
+	};
+
+	int year, month, day;
+	if( !number( 4, year ) || !skip( '-' ) || !number( 2, month ) || !skip( '-' ) ||
+		!number( 2, day ) )
+		return false;
+
+	int64_t usecs = 0;
+	if( p != end && ( *p == ' ' || *p == 'T' ) )
+	{
+		++p;
+		int hours, minutes, seconds = 0;
+		if( !number( 2, hours ) || !skip( ':' ) || !number( 2, minutes ) )
+			return false;
+		if( skip( ':' ) && !number( 2, seconds ) )
+			return false;
+		usecs = ( ( hours * 60LL + minutes ) * 60 + seconds ) * 1000000;
+
+		if( skip( '.' ) )
+		{
+			int64_t scale = 100000;
+			for( ; p != end && *p >= '0' && *p <= '9'; ++p, scale /= 10 )
+				usecs += ( *p - '0' ) * scale;
+		}
+
+		if( p != end && ( *p == '+' || *p == '-' ) )
+		{
+			const int64_t sign = *p++ == '+' ? -1 : 1;
+			int offsetHours, offsetMinutes;
+			if( !number( 2, offsetHours ) || !skip( ':' ) || !number( 2, offsetMinutes ) )
+				return false;
+			usecs += sign * ( offsetHours * 60LL + offsetMinutes ) * 60 * 1000000;
+		}
+		else
+			skip( 'Z' );
+	}
+
+	if( p != end )
+		return false;
+
+	value = datetime( date::sys_days( date::year( year ) / month / day ) ) +
+			std::chrono::microseconds( usecs );
+	return true;
+}
+
+// only white space, comments or empty statements left in a script
+inline bool is_blank( const char* sql, const char* end )
+{
+	while( sql != end )
+	{
+		if( isspace( ( unsigned char )*sql ) || *sql == ';' )
+			++sql;
+		else if( end - sql > 1 && sql[ 0 ] == '-' && sql[ 1 ] == '-' )
+			sql = std::find( sql, end, '\n' );
+		else if( end - sql > 1 && sql[ 0 ] == '/' && sql[ 1 ] == '*' )
+		{
+			const char* close = strstr( sql + 2, "*/" );
+			sql = close && close < end ? close + 2 : end;
+		}
+		else
+			return false;
+	}
+	return true;
+}
+
+inline datetime from_julian_day( double julianDay )
+{
+	constexpr double unixEpoch = 2440587.5;
+	return datetime(
+		std::chrono::microseconds( ( int64_t )( ( julianDay - unixEpoch ) * 86400e6 ) ) );
+}
+
+// binds a member of a bulk inserted row, text is bound without a copy
+template< typename T >
+inline int bind_value( sqlite3_stmt* stmt, int ndx, const T& value )
+{
+	if constexpr( std::is_integral_v< T > )
+		return sqlite3_bind_int64( stmt, ndx, ( int64_t )value );
+	else if constexpr( std::is_floating_point_v< T > )
+		return sqlite3_bind_double( stmt, ndx, value );
+	else if constexpr( std::is_same_v< T, datetime > )
+	{
+		const std::string text = format_datetime( value );
+		return sqlite3_bind_text( stmt, ndx, text.data( ), ( int )text.size( ), SQLITE_TRANSIENT );
+	}
+	else if constexpr( std::is_convertible_v< const T&, std::string_view > )
+	{
+		const std::string_view text( value );
+		return sqlite3_bind_text( stmt, ndx, text.data( ), ( int )text.size( ), SQLITE_STATIC );
+	}
+	else
+		return value ? bind_value( stmt, ndx, *value ) : sqlite3_bind_null( stmt, ndx );
+}
+
+}  // namespace detail
+}  // namespace sqlite
+}  // namespace dbclt
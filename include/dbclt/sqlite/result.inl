@@ -0,0 +1,268 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+namespace dbclt
+{
+namespace sqlite
+{
+inline std::shared_ptr< result_impl > result_impl::create( stmt_ptr stmt )
+{
+	std::shared_ptr< result_impl > ptr( std::make_shared< result_impl >( ) );
+	ptr->init( stmt );
+	return ptr;
+}
+
+inline result_impl::~result_impl( )
+{
+	// ends the read transaction of an unfinished query, the statement may be reused by the cache
+	if( m_stmt )
+		sqlite3_reset( m_stmt.get( ) );
+}
+
+inline void result_impl::init( stmt_ptr stmt )
+{
+	m_stmt = stmt;
+	m_eof = !step( );
+
+	const int fields = sqlite3_column_count( m_stmt.get( ) );
+	if( fields == 0 )
+	{
+		m_changes = sqlite3_changes( sqlite3_db_handle( m_stmt.get( ) ) );
+		m_records = m_changes;
+		return;
+	}
+
+	// declared column types first, the first row's values for expressions
+	m_fields.resize( fields );
+	for( int i = 0; i < fields; ++i )
+		m_fields[ i ] = field( sqlite3_column_name( m_stmt.get( ), i ),
+							   map_db_type( sqlite3_column_decltype( m_stmt.get( ), i ),
+											m_eof ? SQLITE_NULL
+												  : sqlite3_column_type( m_stmt.get( ), i ) ) );
+}
+
+inline bool result_impl::step( )
+{
+	const int rc = sqlite3_step( m_stmt.get( ) );
+	if( rc == SQLITE_ROW )
+	{
+		++m_records;
+		return true;
+	}
+	if( rc == SQLITE_DONE )
+		return false;
+
+	throw data_exception( std::string( "Command failed: " ) + sqlite3_sql( m_stmt.get( ) ) +
+						  " -- " + sqlite3_errmsg( sqlite3_db_handle( m_stmt.get( ) ) ) );
+}
+
+inline size_t result_impl::affected_count( ) const
+{
+	return m_changes;
+}
+
+inline size_t result_impl::record_count( ) const
+{
+	return m_records;
+}
+
+inline const fields_type& result_impl::record_fields( ) const
+{
+	return m_fields;
+}
+
+inline result_impl::recordset_value_type* result_impl::create_record( )
+{
+	return new recordset_value_type( shared_from_this( ) );
+}
+
+inline result_impl::recordset_iterator
+result_impl::begin( std::shared_ptr< recordset_value_type > record )
+{
+	return recordset_iterator( this, record, !m_eof );
+}
+
+inline result_impl::recordset_iterator result_impl::end( )
+{
+	return recordset_iterator( this, false );
+}
+
+inline result_impl::recordset_type result_impl::create_recordset( )
+{
+	return recordset_type( shared_from_this( ) );
+}
+
+inline result_impl::recordsets_type result_impl::create_recordsets( recordset_type& firstRecordset )
+{
+	return recordsets_type( recordsets_iterator( this, &firstRecordset ),
+							recordsets_iterator( this, nullptr ) );
+}
+
+inline void result_impl::next_recordset( recordsets_value_type*& data )
+{
+	data = nullptr;
+}
+
+inline result_impl::recordsets_value_type& result_impl::get_recordset( recordsets_value_type* data )
+{
+	return *data;
+}
+
+inline void result_impl::next_record( bool& data )
+{
+	data = !m_eof && step( );
+	m_eof = !data;
+}
+
+inline result_impl::recordset_value_type& result_impl::get_record( recordset_value_type& record,
+																   bool /*data*/ )
+{
+	return record;
+}
+
+inline bool result_impl::is_null( size_t field ) const
+{
+	return sqlite3_column_type( m_stmt.get( ), ( int )field ) == SQLITE_NULL;
+}
+
+inline std::string result_impl::get_string( size_t field ) const
+{
+	return std::string( get_string_view( field ) );
+}
+
+inline std::string_view result_impl::get_string_view( size_t field ) const
+{
+	// the pointer has to be taken before the size, both stay valid until the next step
+	const void* data = m_fields[ field ].db_type( ) == field::type::db_binary
+						   ? sqlite3_column_blob( m_stmt.get( ), ( int )field )
+						   : sqlite3_column_text( m_stmt.get( ), ( int )field );
+	if( !data )
+		return std::string_view( );
+
+	return std::string_view( ( const char* )data,
+							 sqlite3_column_bytes( m_stmt.get( ), ( int )field ) );
+}
+
+inline bool result_impl::get_bool( size_t field ) const
+{
+	return get_int64( field ) != 0;
+}
+
+inline int8_t result_impl::get_int8( size_t field ) const
+{
+	return ( int8_t )get_int64( field );
+}
+
+inline int16_t result_impl::get_int16( size_t field ) const
+{
+	return ( int16_t )get_int64( field );
+}
+
+inline int32_t result_impl::get_int32( size_t field ) const
+{
+	return ( int32_t )get_int64( field );
+}
+
+inline int64_t result_impl::get_int64( size_t field ) const
+{
+	return sqlite3_column_int64( m_stmt.get( ), ( int )field );
+}
+
+inline float result_impl::get_float( size_t field ) const
+{
+	return ( float )get_double( field );
+}
+
+inline double result_impl::get_double( size_t field ) const
+{
+	return sqlite3_column_double( m_stmt.get( ), ( int )field );
+}
+
+inline datetime result_impl::get_date( size_t field ) const
+{
+	return date::floor< date::days >( get_datetime( field ) );
+}
+
+inline datetime result_impl::get_datetime( size_t field ) const
+{
+	// the storage classes of sqlite's date functions: iso 8601 text, unix time or julian day
+	switch( sqlite3_column_type( m_stmt.get( ), ( int )field ) )
+	{
+	case SQLITE_NULL: return datetime( );
+	case SQLITE_INTEGER: return datetime( std::chrono::seconds( get_int64( field ) ) );
+	case SQLITE_FLOAT: return detail::from_julian_day( get_double( field ) );
+	default: break;
+	}
+
+	datetime value;
+	const std::string_view text = get_string_view( field );
+	if( !detail::parse_datetime( text.data( ), text.size( ), value ) )
+		throw data_exception( "Invalid datetime: " + std::string( text ) );
+
+	return value;
+}
+
+inline field::type result_impl::map_db_type( const char* declType, int storageClass )
+{
+	if( !declType || !*declType )
+	{
+		switch( storageClass )
+		{
+		case SQLITE_INTEGER: return field::type::db_int64;
+		case SQLITE_FLOAT: return field::type::db_double;
+		case SQLITE_BLOB: return field::type::db_binary;
+		default: return field::type::db_string;
+		}
+	}
+
+	// sqlite's affinity rules, refined by the names commonly used for booleans and dates
+	std::string name( declType );
+	std::transform( name.begin( ), name.end( ), name.begin( ), ::toupper );
+	auto contains = [ &name ]( const char* part ) {
+		return name.find( part ) != std::string::npos;
+	};
+
+	if( contains( "BOOL" ) )
+		return field::type::db_bool;
+	if( name == "DATE" )
+		return field::type::db_date;
+	if( contains( "DATE" ) || contains( "TIME" ) )
+		return field::type::db_datetime;
+	if( contains( "INT" ) )
+		return field::type::db_int64;
+	if( contains( "CHAR" ) || contains( "CLOB" ) || contains( "TEXT" ) )
+		return field::type::db_string;
+	if( contains( "BLOB" ) )
+		return field::type::db_binary;
+	if( contains( "REAL" ) || contains( "FLOA" ) || contains( "DOUB" ) || contains( "NUM" ) ||
+		contains( "DEC" ) )
+		return field::type::db_double;
+
+	return field::type::db_string;
+}
+
+}  // namespace sqlite
+}  // namespace dbclt
@@ -0,0 +1,247 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <structs/to_tuple.h>
+
+namespace dbclt
+{
+namespace sqlite
+{
+inline session_impl::~session_impl( )
+{
+	disconnect( );
+}
+
+inline void session_impl::begin_transaction( )
+{
+	if( ++m_transaction == 1 )
+		execute( "begin" );
+	else
+		execute( "savepoint txn" + std::to_string( m_transaction ) );
+}
+
+inline void session_impl::commit_transaction( )
+{
+	if( --m_transaction == 0 )
+		execute( "commit" );
+	else
+		execute( "release savepoint txn" + std::to_string( m_transaction + 1 ) );
+}
+
+inline void session_impl::rollback_transaction( )
+{
+	if( m_transaction > 1 )
+	{
+		const std::string savepoint = "savepoint txn" + std::to_string( m_transaction );
+		execute( "rollback to " + savepoint + ";release " + savepoint );
+	}
+	else
+		execute( "rollback" );
+
+	m_transaction--;
+}
+
+inline bool session_impl::connected( ) const
+{
+	return m_conn.get( );
+}
+
+inline void session_impl::connect( const std::string& connInfo )
+{
+	// a session is only used by one thread at a time, sqlite's own locking is not needed
+	sqlite3* db = nullptr;
+	const int rc = sqlite3_open_v2( connInfo.c_str( ),
+									&db,
+									SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE |
+										SQLITE_OPEN_URI | SQLITE_OPEN_NOMUTEX,
+									nullptr );
+	conn_ptr conn( db );
+	if( rc != SQLITE_OK )
+		throw data_exception( "Connection to database failed: " + connInfo + " -- " +
+							  ( db ? sqlite3_errmsg( db ) : sqlite3_errstr( rc ) ) );
+
+	disconnect( );
+	m_conn = conn;
+	apply_pragmas( );
+}
+
+inline void session_impl::disconnect( )
+{
+	// statements still held by results keep the connection open until they are finalized
+	m_prepared.clear( );
+	m_conn.reset( );
+	m_transaction = 0;
+}
+
+inline session_impl::result_type session_impl::execute( const std::string& stmt )
+{
+	return result_type( result_impl::create( prepare( stmt ) ) );
+}
+
+inline session_impl::recordset_type session_impl::query( const std::string& stmt )
+{
+	result_type result( result_impl::create( prepare( stmt ) ) );
+	return *result.recordsets( ).begin( );
+}
+
+template< typename T >
+inline void session_impl::bulk_insert( const std::string& table, const T& container )
+{
+	using row_type = typename T::value_type;
+	using Tup = decltype( structs::to_tuple( std::declval< row_type& >( ) ) );
+
+	std::string stmtText = "insert into " + table + " values (";
+	for( size_t i = 0; i < std::tuple_size_v< Tup >; ++i )
+		stmtText += i == 0 ? "?" : ",?";
+	stmtText += ")";
+
+	stmt_ptr stmt = prepare( stmtText );
+
+	// all rows are committed together unless the caller already runs a transaction
+	const bool ownTransaction = !m_transaction;
+	if( ownTransaction )
+		begin_transaction( );
+
+	try
+	{
+		for( const row_type& row : container )
+		{
+			// the text of the members is bound in place and has to outlive the step
+			const auto values = structs::to_tuple( row );
+			int ndx = 0;
+			std::apply(
+				[ & ]( const auto&... value ) {
+					( check_error( detail::bind_value( stmt.get( ), ++ndx, value ),
+								   m_conn.get( ),
+								   stmtText ),
+					  ... );
+				},
+				values );
+
+			const int rc = sqlite3_step( stmt.get( ) );
+			sqlite3_reset( stmt.get( ) );
+			check_error( rc, m_conn.get( ), stmtText );
+		}
+		sqlite3_clear_bindings( stmt.get( ) );
+	}
+	catch( ... )
+	{
+		sqlite3_reset( stmt.get( ) );
+		sqlite3_clear_bindings( stmt.get( ) );
+		if( ownTransaction )
+			rollback_transaction( );
+		throw;
+	}
+
+	if( ownTransaction )
+		commit_transaction( );
+}
+
+inline void session_impl::enable_wal( bool enabled )
+{
+	m_wal = enabled;
+	if( connected( ) )
+		apply_pragmas( );
+}
+
+inline void session_impl::set_mmap_size( int64_t bytes )
+{
+	m_mmapSize = bytes;
+	if( connected( ) )
+		apply_pragmas( );
+}
+
+inline void session_impl::apply_pragmas( )
+{
+	// wal only syncs at checkpoints, readers and the writer no longer block each other
+	if( m_wal )
+		execute( "pragma journal_mode=wal;pragma synchronous=normal" );
+	if( m_mmapSize >= 0 )
+		execute( "pragma mmap_size=" + std::to_string( m_mmapSize ) );
+}
+
+inline stmt_ptr session_impl::prepare( const std::string& stmtText )
+{
+	if( !m_conn )
+		throw data_exception( "Connection is not opened" );
+
+	constexpr size_t maxPrepared = 64;
+
+	auto it = m_prepared.find( stmtText );
+	if( it != m_prepared.end( ) && it->second.use_count( ) == 1 )
+	{
+		stmt_ptr& stmt = it->second;
+		sqlite3_reset( stmt.get( ) );
+		sqlite3_clear_bindings( stmt.get( ) );
+		return stmt;
+	}
+
+	// every statement of a script but the last one runs here, only single ones are cached
+	const bool cacheable = it == m_prepared.end( ) && m_prepared.size( ) < maxPrepared;
+	const char* sql = stmtText.c_str( );
+	const char* end = sql + stmtText.size( );
+	stmt_ptr stmt;
+	bool script = false;
+	while( !detail::is_blank( sql, end ) )
+	{
+		if( stmt )
+		{
+			int rc;
+			while( ( rc = sqlite3_step( stmt.get( ) ) ) == SQLITE_ROW )
+				;
+			check_error( rc, m_conn.get( ), stmtText );
+			script = true;
+		}
+
+		sqlite3_stmt* next = nullptr;
+		check_error( sqlite3_prepare_v3( m_conn.get( ),
+										 sql,
+										 ( int )( end - sql ),
+										 cacheable ? SQLITE_PREPARE_PERSISTENT : 0,
+										 &next,
+										 &sql ),
+					 m_conn.get( ),
+					 stmtText );
+		stmt = stmt_ptr( next );
+	}
+
+	if( !stmt )
+		throw data_exception( "Empty statement: " + stmtText );
+
+	if( cacheable && !script )
+		m_prepared.emplace( stmtText, stmt );
+
+	return stmt;
+}
+
+inline void session_impl::check_error( int rc, sqlite3* conn, const std::string& stmt )
+{
+	if( rc != SQLITE_OK && rc != SQLITE_ROW && rc != SQLITE_DONE )
+		throw data_exception( "Command failed: " + stmt + " -- " + sqlite3_errmsg( conn ) );
+}
+
+}  // namespace sqlite
+}  // namespace dbclt
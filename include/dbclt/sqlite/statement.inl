@@ -0,0 +1,171 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+namespace dbclt
+{
+namespace sqlite
+{
+inline statement_impl::statement_impl( session_impl& session ) : m_session( session )
+{
+}
+
+inline statement_impl::result_type statement_impl::execute( const std::string& stmtText )
+{
+	return m_session.execute( stmtText );
+}
+
+inline statement_impl::result_type statement_impl::execute_params( const std::string& stmtText )
+{
+	return result_type( result_impl::create( execute_prepared( stmtText ) ) );
+}
+
+inline statement_impl::recordset_type statement_impl::query( const std::string& stmtText )
+{
+	return m_session.query( stmtText );
+}
+
+inline statement_impl::recordset_type statement_impl::query_params( const std::string& stmtText )
+{
+	result_type result( result_impl::create( execute_prepared( stmtText ) ) );
+	return *result.recordsets( ).begin( );
+}
+
+inline stmt_ptr statement_impl::execute_prepared( const std::string& stmtText )
+{
+	// the values are copied, the bound ones belong to the caller's binders
+	std::vector< parameter > params;
+	params.swap( m_params );
+
+	stmt_ptr stmt = m_session.prepare( stmtText );
+	for( size_t i = 0; i < params.size( ); ++i )
+	{
+		const parameter& param = params[ i ];
+		const int ndx = ( int )i + 1;
+		int rc;
+		switch( param.type )
+		{
+		case SQLITE_INTEGER: rc = sqlite3_bind_int64( stmt.get( ), ndx, param.integer ); break;
+		case SQLITE_FLOAT: rc = sqlite3_bind_double( stmt.get( ), ndx, param.real ); break;
+		default:
+			rc = sqlite3_bind_text( stmt.get( ),
+									ndx,
+									param.text.data( ),
+									( int )param.text.size( ),
+									SQLITE_TRANSIENT );
+			break;
+		}
+		session_impl::check_error( rc, m_session.m_conn.get( ), stmtText );
+	}
+
+	return stmt;
+}
+
+template<>
+inline void statement_impl::bind_parameter( const std::string& value, std::string& bound )
+{
+	m_params.push_back( { SQLITE_TEXT, 0, 0, bound } );
+}
+
+template<>
+inline void statement_impl::bind_parameter( const std::string_view& value, std::string_view& bound )
+{
+	m_params.push_back( { SQLITE_TEXT, 0, 0, bound } );
+}
+
+template<>
+inline void statement_impl::bind_parameter( const bool& value, bool& bound )
+{
+	m_params.push_back( { SQLITE_INTEGER, bound, 0, { } } );
+}
+
+template<>
+inline void statement_impl::bind_parameter( const int8_t& value, int8_t& bound )
+{
+	m_params.push_back( { SQLITE_INTEGER, bound, 0, { } } );
+}
+
+template<>
+inline void statement_impl::bind_parameter( const int16_t& value, int16_t& bound )
+{
+	m_params.push_back( { SQLITE_INTEGER, bound, 0, { } } );
+}
+
+template<>
+inline void statement_impl::bind_parameter( const int32_t& value, int32_t& bound )
+{
+	m_params.push_back( { SQLITE_INTEGER, bound, 0, { } } );
+}
+
+template<>
+inline void statement_impl::bind_parameter( const int64_t& value, int64_t& bound )
+{
+	m_params.push_back( { SQLITE_INTEGER, bound, 0, { } } );
+}
+
+template<>
+inline void statement_impl::bind_parameter( const float& value, float& bound )
+{
+	m_params.push_back( { SQLITE_FLOAT, 0, bound, { } } );
+}
+
+template<>
+inline void statement_impl::bind_parameter( const double& value, double& bound )
+{
+	m_params.push_back( { SQLITE_FLOAT, 0, bound, { } } );
+}
+
+template<>
+inline void statement_impl::bind_parameter( const datetime& value, std::string& bound )
+{
+	m_params.push_back( { SQLITE_TEXT, 0, 0, bound } );
+}
+
+template<>
+inline auto statement_impl::get_binder_traits( const datetime& )
+{
+	struct binder_traits
+	{
+		using user_type = datetime;
+		using bound_type = std::string;
+		using traits = binder_traits;
+
+		static std::string transform( datetime from )
+		{
+			return detail::format_datetime( from );
+		}
+		static datetime transform( const std::string& from )
+		{
+			datetime value;
+			detail::parse_datetime( from.c_str( ), from.size( ), value );
+			return value;
+		}
+	};
+
+	return binder_traits( );
+}
+
+}  // namespace sqlite
+}  // namespace dbclt
@@ -0,0 +1,101 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <iterator>
+
+namespace dbclt
+{
+template< typename BE, typename Row >
+class typed_recordset
+{
+public:
+	using backend_type = BE;
+	using recordset_ptr = std::shared_ptr< BE >;
+	using value_type = Row;
+
+	class iterator
+	{
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type = Row;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const Row*;
+		using reference = Row;
+
+	public:
+		iterator( )
+		{
+		}
+
+		iterator( const backend_type* impl, size_t row ) : m_impl( impl ), m_row( row )
+		{
+		}
+
+		iterator& operator++( )
+		{
+			++m_row;
+			return *this;
+		}
+
+		bool operator!=( const iterator& other ) const
+		{
+			return m_row != other.m_row;
+		}
+
+		bool operator==( const iterator& other ) const
+		{
+			return m_row == other.m_row;
+		}
+
+		Row operator*( ) const
+		{
+			return m_impl->template decode_row< Row >( m_row );
+		}
+
+	private:
+		const backend_type* m_impl { nullptr };
+		size_t m_row { 0 };
+	};
+
+public:
+	typed_recordset( recordset_ptr impl );
+
+	bool empty( ) const;
+	size_t record_count( ) const;
+
+	const fields_type& fields( ) const;
+
+	template< typename T >
+	T& into( T& container );
+
+	iterator begin( ) const;
+	iterator end( ) const;
+
+private:
+	recordset_ptr m_impl;
+};
+
+}  // namespace dbclt
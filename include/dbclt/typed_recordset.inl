@@ -0,0 +1,77 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+namespace dbclt
+{
+template< typename BE, typename Row >
+inline typed_recordset< BE, Row >::typed_recordset( recordset_ptr impl ) : m_impl( impl )
+{
+	// the field types are validated once, rows are then decoded without any checks
+	m_impl->template check_row< Row >( );
+}
+
+template< typename BE, typename Row >
+inline bool typed_recordset< BE, Row >::empty( ) const
+{
+	return m_impl->record_count( ) == 0;
+}
+
+template< typename BE, typename Row >
+inline size_t typed_recordset< BE, Row >::record_count( ) const
+{
+	return m_impl->record_count( );
+}
+
+template< typename BE, typename Row >
+inline const fields_type& typed_recordset< BE, Row >::fields( ) const
+{
+	return m_impl->record_fields( );
+}
+
+template< typename BE, typename Row >
+template< typename T >
+inline T& typed_recordset< BE, Row >::into( T& container )
+{
+	const size_t records = m_impl->record_count( );
+	for( size_t i = 0; i < records; ++i )
+		container.emplace_back( m_impl->template decode_row< Row >( i ) );
+
+	return container;
+}
+
+template< typename BE, typename Row >
+inline typename typed_recordset< BE, Row >::iterator typed_recordset< BE, Row >::begin( ) const
+{
+	return iterator( m_impl.get( ), 0 );
+}
+
+template< typename BE, typename Row >
+inline typename typed_recordset< BE, Row >::iterator typed_recordset< BE, Row >::end( ) const
+{
+	return iterator( m_impl.get( ), m_impl->record_count( ) );
+}
+
+}  // namespace dbclt
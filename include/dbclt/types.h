@@ -0,0 +1,276 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+namespace dbclt
+{
+// 16 bytes in network order
+struct uuid
+{
+	uuid( );
+	explicit uuid( std::string_view text );
+
+	std::string to_string( ) const;
+
+	bool operator==( const uuid& other ) const;
+	bool operator!=( const uuid& other ) const;
+
+	std::array< uint8_t, 16 > bytes;
+};
+
+// months and days are kept apart from the time since their length varies
+struct interval
+{
+	std::string to_string( ) const;
+
+	bool operator==( const interval& other ) const;
+	bool operator!=( const interval& other ) const;
+
+	int32_t months { 0 };
+	int32_t days { 0 };
+	int64_t microseconds { 0 };
+};
+
+// ipv4 or ipv6 host or network address, the unused bytes of an ipv4 address are zero
+struct inet
+{
+	enum class family : uint8_t
+	{
+		ipv4 = 4,
+		ipv6 = 6
+	};
+
+	inet( );
+
+	// the prefix length is omitted for host addresses
+	std::string to_string( ) const;
+
+	bool operator==( const inet& other ) const;
+	bool operator!=( const inet& other ) const;
+
+	family address_family;
+	uint8_t bits;
+	bool cidr;
+	std::array< uint8_t, 16 > address;
+};
+
+namespace detail
+{
+inline int hex_value( char c )
+{
+	if( c >= '0' && c <= '9' )
+		return c - '0';
+	if( ( c | 0x20 ) >= 'a' && ( c | 0x20 ) <= 'f' )
+		return ( c | 0x20 ) - 'a' + 10;
+	return -1;
+}
+
+// whole seconds padded to width, then the fraction without its trailing zeros
+inline std::string format_seconds( int64_t usecs, int width )
+{
+	char buffer[ 32 ];
+	int size = snprintf( buffer, sizeof( buffer ), "%0*d", width, ( int )( usecs / 1000000 ) );
+	if( usecs % 1000000 )
+	{
+		size += snprintf( buffer + size, sizeof( buffer ) - size, ".%06d",
+						  ( int )( usecs % 1000000 ) );
+		while( buffer[ size - 1 ] == '0' )
+			--size;
+	}
+	return std::string( buffer, size );
+}
+
+inline std::string format_time( const time_of_day& value )
+{
+	const int64_t usecs = value.count( );
+	char buffer[ 16 ];
+	const int size = snprintf( buffer, sizeof( buffer ), "%02d:%02d:",
+							   ( int )( usecs / 3600000000LL ), ( int )( usecs / 60000000 % 60 ) );
+	return std::string( buffer, size ) + format_seconds( usecs % 60000000, 2 );
+}
+
+}  // namespace detail
+
+inline uuid::uuid( ) : bytes { }
+{
+}
+
+inline uuid::uuid( std::string_view text ) : bytes { }
+{
+	// canonical 8-4-4-4-12 form, braces and dashes are optional
+	if( text.size( ) >= 2 && text.front( ) == '{' && text.back( ) == '}' )
+		text = text.substr( 1, text.size( ) - 2 );
+
+	size_t count = 0;
+	for( size_t i = 0; i < text.size( ); ++i )
+	{
+		if( text[ i ] == '-' )
+			continue;
+		const int high = detail::hex_value( text[ i ] );
+		const int low = i + 1 < text.size( ) ? detail::hex_value( text[ i + 1 ] ) : -1;
+		if( high < 0 || low < 0 || count == bytes.size( ) )
+			throw data_exception( "Invalid uuid: " + std::string( text ) );
+		bytes[ count++ ] = ( uint8_t )( high << 4 | low );
+		++i;
+	}
+
+	if( count != bytes.size( ) )
+		throw data_exception( "Invalid uuid: " + std::string( text ) );
+}
+
+inline std::string uuid::to_string( ) const
+{
+	static const char hex[] = "0123456789abcdef";
+	std::string text;
+	text.reserve( 36 );
+	for( size_t i = 0; i < bytes.size( ); ++i )
+	{
+		if( i == 4 || i == 6 || i == 8 || i == 10 )
+			text.push_back( '-' );
+		text.push_back( hex[ bytes[ i ] >> 4 ] );
+		text.push_back( hex[ bytes[ i ] & 0xf ] );
+	}
+	return text;
+}
+
+inline bool uuid::operator==( const uuid& other ) const
+{
+	return bytes == other.bytes;
+}
+
+inline bool uuid::operator!=( const uuid& other ) const
+{
+	return bytes != other.bytes;
+}
+
+inline std::string interval::to_string( ) const
+{
+	// iso 8601 duration, each part carries its own sign
+	std::string text( "P" );
+	auto part = [ &text ]( int64_t value, char unit ) {
+		if( value )
+			text.append( std::to_string( value ) ).push_back( unit );
+	};
+
+	part( months / 12, 'Y' );
+	part( months % 12, 'M' );
+	part( days, 'D' );
+	if( microseconds || text.size( ) == 1 )
+	{
+		text.push_back( 'T' );
+		part( microseconds / 3600000000LL, 'H' );
+		part( microseconds / 60000000 % 60, 'M' );
+
+		const int64_t usecs = microseconds % 60000000;
+		if( usecs || text.back( ) == 'T' )
+		{
+			if( usecs < 0 )
+				text.push_back( '-' );
+			text.append( detail::format_seconds( usecs < 0 ? -usecs : usecs, 1 ) ).push_back( 'S' );
+		}
+	}
+	return text;
+}
+
+inline bool interval::operator==( const interval& other ) const
+{
+	return months == other.months && days == other.days && microseconds == other.microseconds;
+}
+
+inline bool interval::operator!=( const interval& other ) const
+{
+	return !( *this == other );
+}
+
+inline inet::inet( ) : address_family( family::ipv4 ), bits( 32 ), cidr( false ), address { }
+{
+}
+
+inline std::string inet::to_string( ) const
+{
+	char buffer[ 64 ];
+	int size = 0;
+	if( address_family == family::ipv4 )
+		size = snprintf( buffer, sizeof( buffer ), "%u.%u.%u.%u", address[ 0 ], address[ 1 ],
+						 address[ 2 ], address[ 3 ] );
+	else
+	{
+		// the longest run of two or more zero groups is written as ::
+		uint16_t groups[ 8 ];
+		for( int i = 0; i < 8; ++i )
+			groups[ i ] = ( uint16_t )( address[ i * 2 ] << 8 | address[ i * 2 + 1 ] );
+
+		int zeroStart = -1, zeroLength = 0;
+		for( int i = 0; i < 8; )
+		{
+			int j = i;
+			while( j < 8 && groups[ j ] == 0 )
+				++j;
+			if( j - i > zeroLength && j - i >= 2 )
+			{
+				zeroStart = i;
+				zeroLength = j - i;
+			}
+			i = j == i ? i + 1 : j;
+		}
+
+		for( int i = 0; i < 8; ++i )
+		{
+			if( i == zeroStart )
+			{
+				size += snprintf( buffer + size, sizeof( buffer ) - size, "::" );
+				i += zeroLength - 1;
+				continue;
+			}
+			if( i > 0 && buffer[ size - 1 ] != ':' )
+				buffer[ size++ ] = ':';
+			size += snprintf( buffer + size, sizeof( buffer ) - size, "%x", groups[ i ] );
+		}
+	}
+
+	const unsigned maxBits = address_family == family::ipv4 ? 32 : 128;
+	if( cidr || bits != maxBits )
+		size += snprintf( buffer + size, sizeof( buffer ) - size, "/%u", bits );
+	return std::string( buffer, size );
+}
+
+inline bool inet::operator==( const inet& other ) const
+{
+	return address_family == other.address_family && bits == other.bits &&
+		   cidr == other.cidr && address == other.address;
+}
+
+inline bool inet::operator!=( const inet& other ) const
+{
+	return !( *this == other );
+}
+
+}  // namespace dbclt
@@ -41,6 +41,10 @@ T big_to_native32( T value );
 template< typename T >
 T big_to_native64( T value );
 
+// big endian value at any alignment, e.g. inside a composite
+template< typename T >
+T read_big( const void* value );
+
 inline void swap16( void* value )
 {
 	union
@@ -112,5 +116,18 @@ inline T big_to_native64( T value )
 	return value;
 }
 
+template< typename T >
+inline T read_big( const void* value )
+{
+	T result;
+	memcpy( &result, value, sizeof( result ) );
+	if constexpr( sizeof( T ) == 2 )
+		return big_to_native16( result );
+	else if constexpr( sizeof( T ) == 4 )
+		return big_to_native32( result );
+	else
+		return big_to_native64( result );
+}
+
 }  // namespace util
 }  // namespace dbclt
@@ -0,0 +1,708 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "datetime.h"
+
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <string_view>
+
+#ifdef WIN32
+	#include <io.h>
+#else
+	#include <unistd.h>
+#endif
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+	#include <emmintrin.h>
+	#define DBCLT_SSE2 1
+#endif
+
+namespace dbclt
+{
+enum class text_format
+{
+	csv,
+	tsv,
+	jsonl
+};
+
+class ostream_sink
+{
+public:
+	ostream_sink( std::ostream& os );
+
+	void write( const char* data, size_t size );
+
+private:
+	std::ostream& m_os;
+};
+
+class fd_sink
+{
+public:
+	fd_sink( int fd );
+
+	void write( const char* data, size_t size );
+
+private:
+	int m_fd;
+};
+
+class memory_sink
+{
+public:
+	memory_sink( std::vector< char >& buffer );
+
+	void write( const char* data, size_t size );
+
+private:
+	std::vector< char >& m_buffer;
+};
+
+template< typename Sink >
+class output_buffer
+{
+public:
+	static constexpr size_t default_capacity = 1024 * 1024;
+
+public:
+	output_buffer( Sink sink, size_t capacity = default_capacity );
+
+	char* reserve( size_t size );
+	void commit( char* end );
+
+	void put( char c );
+	void append( const char* data, size_t size );
+	void append( std::string_view data );
+	void flush( );
+
+private:
+	Sink m_sink;
+	std::unique_ptr< char[] > m_buffer;
+	size_t m_capacity;
+	size_t m_size { 0 };
+
+private:
+	output_buffer( const output_buffer& ) = delete;
+	output_buffer& operator=( const output_buffer& ) = delete;
+};
+
+namespace detail
+{
+class escape_scanner
+{
+public:
+	escape_scanner( std::string_view specials, bool controls );
+
+	const char* find( const char* begin, const char* end ) const;
+	bool is_special( char c ) const;
+
+private:
+	bool m_table[ 256 ];
+	char m_chars[ 4 ];
+	bool m_controls;
+};
+
+char* format_2digits( char* out, unsigned value );
+char* format_days( char* out, int64_t days );
+void split_datetime( const datetime& value, int64_t& days, int64_t& usecs );
+char* format_date( char* out, const datetime& value );
+char* format_datetime( char* out, const datetime& value );
+
+constexpr size_t max_datetime_length = 40;
+}  // namespace detail
+
+template< typename Sink >
+class text_writer
+{
+public:
+	text_writer( Sink sink, text_format format, char delimiter = ',' );
+
+	void header( const fields_type& fields );
+
+	template< typename R >
+	void write( const R& record );
+
+	void flush( );
+
+private:
+	void set_fields( const fields_type& fields );
+	void write_name( size_t ndx );
+	void write_string( std::string_view value );
+	void write_binary( std::string_view value );
+	void write_csv_string( std::string_view value );
+	void write_tsv_string( std::string_view value );
+	void write_json_string( std::string_view value );
+
+	template< typename T >
+	void write_number( T value );
+
+private:
+	output_buffer< Sink > m_out;
+	text_format m_format;
+	char m_delimiter;
+	std::vector< field::type > m_types;
+	std::vector< std::string > m_names;
+	detail::escape_scanner m_scanner;
+};
+
+inline ostream_sink::ostream_sink( std::ostream& os ) : m_os( os )
+{
+}
+
+inline void ostream_sink::write( const char* data, size_t size )
+{
+	m_os.write( data, ( std::streamsize )size );
+	if( !m_os )
+		throw data_exception( "Cannot write to output stream" );
+}
+
+inline fd_sink::fd_sink( int fd ) : m_fd( fd )
+{
+}
+
+inline void fd_sink::write( const char* data, size_t size )
+{
+	while( size > 0 )
+	{
+#ifdef WIN32
+		const int written = _write( m_fd, data, ( unsigned int )size );
+#else
+		const ssize_t written = ::write( m_fd, data, size );
+#endif
+		if( written < 0 )
+		{
+			if( errno == EINTR )
+				continue;
+			throw data_exception( std::string( "Cannot write to file descriptor: " ) +
+								  strerror( errno ) );
+		}
+
+		data += written;
+		size -= ( size_t )written;
+	}
+}
+
+inline memory_sink::memory_sink( std::vector< char >& buffer ) : m_buffer( buffer )
+{
+}
+
+inline void memory_sink::write( const char* data, size_t size )
+{
+	m_buffer.insert( m_buffer.end( ), data, data + size );
+}
+
+template< typename Sink >
+inline output_buffer< Sink >::output_buffer( Sink sink, size_t capacity )
+	: m_sink( sink ),
+	  m_buffer( new char[ capacity ] ),
+	  m_capacity( capacity )
+{
+}
+
+template< typename Sink >
+inline char* output_buffer< Sink >::reserve( size_t size )
+{
+	if( m_capacity - m_size < size )
+		flush( );
+	return m_buffer.get( ) + m_size;
+}
+
+template< typename Sink >
+inline void output_buffer< Sink >::commit( char* end )
+{
+	m_size = end - m_buffer.get( );
+}
+
+template< typename Sink >
+inline void output_buffer< Sink >::put( char c )
+{
+	if( m_size == m_capacity )
+		flush( );
+	m_buffer[ m_size++ ] = c;
+}
+
+template< typename Sink >
+inline void output_buffer< Sink >::append( const char* data, size_t size )
+{
+	if( m_capacity - m_size < size )
+	{
+		flush( );
+		if( size >= m_capacity )
+		{
+			m_sink.write( data, size );
+			return;
+		}
+	}
+
+	memcpy( m_buffer.get( ) + m_size, data, size );
+	m_size += size;
+}
+
+template< typename Sink >
+inline void output_buffer< Sink >::append( std::string_view data )
+{
+	append( data.data( ), data.size( ) );
+}
+
+template< typename Sink >
+inline void output_buffer< Sink >::flush( )
+{
+	if( m_size > 0 )
+	{
+		m_sink.write( m_buffer.get( ), m_size );
+		m_size = 0;
+	}
+}
+
+namespace detail
+{
+inline escape_scanner::escape_scanner( std::string_view specials, bool controls )
+	: m_controls( controls )
+{
+	memset( m_table, 0, sizeof( m_table ) );
+	for( size_t c = 0; c < 0x20 && controls; ++c )
+		m_table[ c ] = true;
+
+	for( size_t i = 0; i < sizeof( m_chars ); ++i )
+	{
+		m_chars[ i ] = specials.empty( ) ? 0 : specials[ std::min( i, specials.size( ) - 1 ) ];
+		if( i < specials.size( ) )
+			m_table[ ( unsigned char )specials[ i ] ] = true;
+	}
+}
+
+inline bool escape_scanner::is_special( char c ) const
+{
+	return m_table[ ( unsigned char )c ];
+}
+
+inline const char* escape_scanner::find( const char* begin, const char* end ) const
+{
+#if DBCLT_SSE2
+	const __m128i c0 = _mm_set1_epi8( m_chars[ 0 ] );
+	const __m128i c1 = _mm_set1_epi8( m_chars[ 1 ] );
+	const __m128i c2 = _mm_set1_epi8( m_chars[ 2 ] );
+	const __m128i c3 = _mm_set1_epi8( m_chars[ 3 ] );
+	const __m128i ctl = _mm_set1_epi8( 0x1f );
+	while( end - begin >= 16 )
+	{
+		const __m128i v = _mm_loadu_si128( ( const __m128i* )begin );
+		__m128i hits = _mm_or_si128(
+			_mm_or_si128( _mm_cmpeq_epi8( v, c0 ), _mm_cmpeq_epi8( v, c1 ) ),
+			_mm_or_si128( _mm_cmpeq_epi8( v, c2 ), _mm_cmpeq_epi8( v, c3 ) ) );
+		if( m_controls )
+			hits = _mm_or_si128( hits, _mm_cmpeq_epi8( _mm_min_epu8( v, ctl ), v ) );
+
+		const int mask = _mm_movemask_epi8( hits );
+		if( mask != 0 )
+		{
+			for( int i = 0; i < 16; ++i )
+				if( mask & ( 1 << i ) )
+					return begin + i;
+		}
+		begin += 16;
+	}
+#endif
+	for( ; begin != end; ++begin )
+		if( is_special( *begin ) )
+			return begin;
+	return end;
+}
+
+inline char* format_2digits( char* out, unsigned value )
+{
+	static const char digits[] = "00010203040506070809"
+								 "10111213141516171819"
+								 "20212223242526272829"
+								 "30313233343536373839"
+								 "40414243444546474849"
+								 "50515253545556575859"
+								 "60616263646566676869"
+								 "70717273747576777879"
+								 "80818283848586878889"
+								 "90919293949596979899";
+	out[ 0 ] = digits[ value * 2 ];
+	out[ 1 ] = digits[ value * 2 + 1 ];
+	return out + 2;
+}
+
+inline char* format_days( char* out, int64_t days )
+{
+	// civil from days, see http://howardhinnant.github.io/date_algorithms.html
+	days += 719468;
+	const int64_t era = ( days >= 0 ? days : days - 146096 ) / 146097;
+	const unsigned doe = ( unsigned )( days - era * 146097 );
+	const unsigned yoe = ( doe - doe / 1460 + doe / 36524 - doe / 146096 ) / 365;
+	const unsigned doy = doe - ( 365 * yoe + yoe / 4 - yoe / 100 );
+	const unsigned mp = ( 5 * doy + 2 ) / 153;
+	const unsigned day = doy - ( 153 * mp + 2 ) / 5 + 1;
+	const unsigned month = mp < 10 ? mp + 3 : mp - 9;
+	const int64_t year = ( int64_t )yoe + era * 400 + ( month <= 2 );
+
+	if( year >= 0 && year <= 9999 )
+	{
+		out = format_2digits( out, ( unsigned )year / 100 );
+		out = format_2digits( out, ( unsigned )year % 100 );
+	}
+	else
+		out = std::to_chars( out, out + 20, year ).ptr;
+
+	*out++ = '-';
+	out = format_2digits( out, month );
+	*out++ = '-';
+	return format_2digits( out, day );
+}
+
+inline void split_datetime( const datetime& value, int64_t& days, int64_t& usecs )
+{
+	constexpr int64_t usecsPerDay = 86400LL * 1000000;
+	const int64_t ts = value.time_since_epoch( ).count( );
+	days = ts / usecsPerDay;
+	usecs = ts % usecsPerDay;
+	if( usecs < 0 )
+	{
+		--days;
+		usecs += usecsPerDay;
+	}
+}
+
+inline char* format_date( char* out, const datetime& value )
+{
+	int64_t days, usecs;
+	split_datetime( value, days, usecs );
+	return format_days( out, days );
+}
+
+inline char* format_datetime( char* out, const datetime& value )
+{
+	int64_t days, usecs;
+	split_datetime( value, days, usecs );
+	out = format_days( out, days );
+
+	const unsigned secs = ( unsigned )( usecs / 1000000 );
+	const unsigned fraction = ( unsigned )( usecs % 1000000 );
+	*out++ = 'T';
+	out = format_2digits( out, secs / 3600 );
+	*out++ = ':';
+	out = format_2digits( out, secs / 60 % 60 );
+	*out++ = ':';
+	out = format_2digits( out, secs % 60 );
+	*out++ = '.';
+	out = format_2digits( out, fraction / 10000 );
+	out = format_2digits( out, fraction / 100 % 100 );
+	return format_2digits( out, fraction % 100 );
+}
+
+}  // namespace detail
+
+template< typename Sink >
+inline text_writer< Sink >::text_writer( Sink sink, text_format format, char delimiter )
+	: m_out( sink ),
+	  m_format( format ),
+	  m_delimiter( format == text_format::tsv ? '\t' : delimiter ),
+	  m_scanner( format == text_format::csv ? std::string( { '"', '\n', '\r', delimiter } )
+			   : format == text_format::tsv ? std::string( "\\\t\n\r" )
+											: std::string( "\"\\" ),
+				 format == text_format::jsonl )
+{
+}
+
+template< typename Sink >
+inline void text_writer< Sink >::header( const fields_type& fields )
+{
+	set_fields( fields );
+	if( m_format == text_format::jsonl )
+		return;
+
+	for( size_t i = 0; i < fields.size( ); ++i )
+	{
+		if( i > 0 )
+			m_out.put( m_delimiter );
+		write_string( fields[ i ].name( ) );
+	}
+	m_out.put( '\n' );
+}
+
+template< typename Sink >
+inline void text_writer< Sink >::set_fields( const fields_type& fields )
+{
+	m_types.clear( );
+	m_names.clear( );
+	for( const field& fld: fields )
+	{
+		m_types.emplace_back( fld.db_type( ) );
+		if( m_format == text_format::jsonl )
+		{
+			// names are escaped once, they are repeated on every line
+			m_names.emplace_back( );
+			for( char c: fld.name( ) )
+			{
+				if( c == '"' || c == '\\' )
+					m_names.back( ) += '\\';
+				m_names.back( ) += c;
+			}
+		}
+	}
+}
+
+template< typename Sink >
+template< typename R >
+inline void text_writer< Sink >::write( const R& record )
+{
+	// without a header( ) call the names line is left out
+	if( m_types.size( ) != record.fields( ).size( ) )
+		set_fields( record.fields( ) );
+
+	if( m_format == text_format::jsonl )
+		m_out.put( '{' );
+
+	for( size_t i = 0; i < m_types.size( ); ++i )
+	{
+		if( m_format == text_format::jsonl )
+			write_name( i );
+		else if( i > 0 )
+			m_out.put( m_delimiter );
+
+		if( record.is_null( i ) )
+		{
+			if( m_format == text_format::tsv )
+				m_out.append( "\\N", 2 );
+			else if( m_format == text_format::jsonl )
+				m_out.append( "null", 4 );
+			continue;
+		}
+
+		switch( m_types[ i ] )
+		{
+		case field::type::db_bool:
+			if( record.get_bool( i ) )
+				m_out.append( "true", 4 );
+			else
+				m_out.append( "false", 5 );
+			break;
+		case field::type::db_int8: write_number( ( int32_t )record.get_int8( i ) ); break;
+		case field::type::db_int16: write_number( record.get_int16( i ) ); break;
+		case field::type::db_int32: write_number( record.get_int32( i ) ); break;
+		case field::type::db_int64: write_number( record.get_int64( i ) ); break;
+		case field::type::db_float: write_number( record.get_float( i ) ); break;
+		case field::type::db_double: write_number( record.get_double( i ) ); break;
+		case field::type::db_binary: write_binary( record.get_string_view( i ) ); break;
+		case field::type::db_date:
+		case field::type::db_datetime:
+		{
+			const bool quoted = m_format == text_format::jsonl;
+			char* out = m_out.reserve( detail::max_datetime_length + 2 );
+			if( quoted )
+				*out++ = '"';
+			out = m_types[ i ] == field::type::db_date
+					  ? detail::format_date( out, record.get_date( i ) )
+					  : detail::format_datetime( out, record.get_datetime( i ) );
+			if( quoted )
+				*out++ = '"';
+			m_out.commit( out );
+			break;
+		}
+		case field::type::db_time:
+		case field::type::db_interval:
+		case field::type::db_uuid:
+		case field::type::db_inet: write_string( record.get_string( i ) ); break;
+		default: write_string( record.get_string_view( i ) );
+		}
+	}
+
+	if( m_format == text_format::jsonl )
+		m_out.put( '}' );
+	m_out.put( '\n' );
+}
+
+template< typename Sink >
+inline void text_writer< Sink >::flush( )
+{
+	m_out.flush( );
+}
+
+template< typename Sink >
+inline void text_writer< Sink >::write_name( size_t ndx )
+{
+	if( ndx > 0 )
+		m_out.put( ',' );
+	m_out.put( '"' );
+	m_out.append( m_names[ ndx ] );
+	m_out.append( "\":", 2 );
+}
+
+template< typename Sink >
+template< typename T >
+inline void text_writer< Sink >::write_number( T value )
+{
+	// json has no nan or infinity
+	if constexpr( std::is_floating_point_v< T > )
+		if( m_format == text_format::jsonl && !std::isfinite( value ) )
+		{
+			m_out.append( "null", 4 );
+			return;
+		}
+
+	constexpr size_t maxLength = 32;
+	char* out = m_out.reserve( maxLength );
+	std::to_chars_result res = std::to_chars( out, out + maxLength, value );
+	m_out.commit( res.ptr );
+}
+
+template< typename Sink >
+inline void text_writer< Sink >::write_string( std::string_view value )
+{
+	switch( m_format )
+	{
+	case text_format::csv: write_csv_string( value ); break;
+	case text_format::tsv: write_tsv_string( value ); break;
+	case text_format::jsonl: write_json_string( value ); break;
+	}
+}
+
+template< typename Sink >
+inline void text_writer< Sink >::write_binary( std::string_view value )
+{
+	static const char hex[] = "0123456789abcdef";
+
+	const bool quoted = m_format == text_format::jsonl;
+	if( quoted )
+		m_out.put( '"' );
+	m_out.append( quoted ? "\\\\x" : "\\x", quoted ? 3 : 2 );
+
+	constexpr size_t chunk = 4096;
+	for( size_t offset = 0; offset < value.size( ); offset += chunk )
+	{
+		const size_t size = std::min( chunk, value.size( ) - offset );
+		char* out = m_out.reserve( size * 2 );
+		for( size_t i = 0; i < size; ++i )
+		{
+			const unsigned char c = ( unsigned char )value[ offset + i ];
+			*out++ = hex[ c >> 4 ];
+			*out++ = hex[ c & 0x0f ];
+		}
+		m_out.commit( out );
+	}
+
+	if( quoted )
+		m_out.put( '"' );
+}
+
+template< typename Sink >
+inline void text_writer< Sink >::write_csv_string( std::string_view value )
+{
+	const char* begin = value.data( );
+	const char* end = begin + value.size( );
+	const char* special = m_scanner.find( begin, end );
+	if( special == end )
+	{
+		m_out.append( begin, value.size( ) );
+		return;
+	}
+
+	m_out.put( '"' );
+	while( true )
+	{
+		const char* quote = ( const char* )memchr( begin, '"', end - begin );
+		if( quote == nullptr )
+		{
+			m_out.append( begin, end - begin );
+			break;
+		}
+
+		m_out.append( begin, quote - begin + 1 );
+		m_out.put( '"' );
+		begin = quote + 1;
+	}
+	m_out.put( '"' );
+}
+
+template< typename Sink >
+inline void text_writer< Sink >::write_tsv_string( std::string_view value )
+{
+	const char* begin = value.data( );
+	const char* end = begin + value.size( );
+	while( begin != end )
+	{
+		const char* special = m_scanner.find( begin, end );
+		m_out.append( begin, special - begin );
+		if( special == end )
+			break;
+
+		m_out.put( '\\' );
+		switch( *special )
+		{
+		case '\t': m_out.put( 't' ); break;
+		case '\n': m_out.put( 'n' ); break;
+		case '\r': m_out.put( 'r' ); break;
+		default: m_out.put( *special );
+		}
+		begin = special + 1;
+	}
+}
+
+template< typename Sink >
+inline void text_writer< Sink >::write_json_string( std::string_view value )
+{
+	static const char hex[] = "0123456789abcdef";
+
+	const char* begin = value.data( );
+	const char* end = begin + value.size( );
+	m_out.put( '"' );
+	while( begin != end )
+	{
+		const char* special = m_scanner.find( begin, end );
+		m_out.append( begin, special - begin );
+		if( special == end )
+			break;
+
+		m_out.put( '\\' );
+		switch( *special )
+		{
+		case '"':
+		case '\\': m_out.put( *special ); break;
+		case '\b': m_out.put( 'b' ); break;
+		case '\f': m_out.put( 'f' ); break;
+		case '\n': m_out.put( 'n' ); break;
+		case '\r': m_out.put( 'r' ); break;
+		case '\t': m_out.put( 't' ); break;
+		default:
+			m_out.append( "u00", 3 );
+			m_out.put( hex[ ( unsigned char )*special >> 4 ] );
+			m_out.put( hex[ *special & 0x0f ] );
+		}
+		begin = special + 1;
+	}
+	m_out.put( '"' );
+}
+
+}  // namespace dbclt
@@ -22,9 +22,11 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
 #include <catch2/catch.hpp>
 
 #include <iostream>
+#include <sstream>
 
 #include <dbclt/odbc.h>
 
@@ -77,21 +79,11 @@ static const std::string connInfo( env( "DBXX_TEST_ODBC_POSTGRES_CONNSTRING",
 										"ANSI;SERVER=localhost;PORT=5432;DATABASE=Vision;UID="
 										"postgres;PWD=secret;BoolsAsChar=0" ) );
 
+static const std::string benchConnInfo( env( "DBXX_TEST_ODBC_BENCH_CONNSTRING",
+											 "DRIVER=SQLite3;DATABASE=dbclt_bench.db" ) );
+
 struct MyRecord
 {
-	MyRecord( )
-	{
-	}
-	MyRecord( std::optional< std::string > t,
-			  std::optional< int32_t > i,
-			  std::optional< int64_t > bi,
-			  std::optional< double > f,
-			  std::optional< bool > b,
-			  std::optional< std::string > tt,
-			  std::optional< dbclt::datetime > dt )
-	{
-	}
-
 	std::optional< std::string > t;
 	std::optional< int32_t > i;
 	std::optional< int64_t > bi;
@@ -144,6 +136,22 @@ void convert( const dbclt::record< BE >& from, MyRecord& to )
 }
 }  // namespace dbclt
 
+static std::vector< MyRecord > make_records( int32_t count )
+{
+	std::vector< MyRecord > records;
+	for( int32_t i = 0; i < count; ++i )
+		records.push_back( MyRecord {
+			"t" + std::to_string( i ),
+			i,
+			1234567890123456789 + i,
+			i / 4.0,
+			i % 2 == 0,
+			i % 3 == 0 ? std::optional< std::string >( ) : "tt" + std::to_string( i ),
+			dbclt::datetime( date::sys_days( date::year( 2019 ) / 12 / 9 ) +
+							 std::chrono::seconds( i ) ) } );
+	return records;
+}
+
 TEST_CASE( "odbc" )
 {
 	SECTION( "NotInitialized" )
@@ -192,6 +200,20 @@ TEST_CASE( "odbc" )
 		REQUIRE( rs.record_count( ) == 1 );
 	}
 
+	SECTION( "ConnectionPool" )
+	{
+		dbclt::odbc::connection_pool pool( connInfo );
+		pool.open( 4 );
+
+		dbclt::odbc::session session = pool.connect( );
+		REQUIRE( session.connected( ) );
+		REQUIRE( session.query( "select 1" ).record_count( ) == 1 );
+
+		session.reconnect( );
+		REQUIRE( session.connected( ) );
+		REQUIRE( session.query( "select 1" ).record_count( ) == 1 );
+	}
+
 	SECTION( "Simple" )
 	{
 		dbclt::odbc::session session;
@@ -262,6 +284,9 @@ TEST_CASE( "odbc" )
 			dbclt::odbc::recordset rs = session.query( "select * from tmp" );
 			REQUIRE( rs.record_count( ) == 1 );
 
+			// the convert( ) overload above keeps every row off the bulk fetch
+			static_assert( !dbclt::detail::has_default_convert< dbclt::odbc::result_impl,
+																MyRecord >::value );
 			std::vector< MyRecord > records;
 			rs.into( records );
 			REQUIRE( records.size( ) == 1 );
@@ -304,30 +329,291 @@ TEST_CASE( "odbc" )
 		}
 	}
 
-	SECTION( "BulkInsert" )
+	SECTION( "ParamBinding" )
 	{
 		dbclt::odbc::session session;
 		session.connect( connInfo );
 		session.execute( "create temp table tmp (t varchar(100) null, i integer null, bi bigint "
 						 "null, f float null, b boolean null, tt text null, dt timestamp null)" );
 
-#if 0
-		std::vector< MyRecord > toInsert =
+		const std::string s1 = "t1";
+		const int32_t i1 = 1;
+		const int64_t i2 = 1234567890123456789;
+		const double f = 1.1;
+		const bool b = true;
+		const std::string tt = "long text";
+		const dbclt::datetime dt( date::sys_days( date::year( 2019 ) / 12 / 9 ) +
+								  std::chrono::microseconds( 123456 ) );
+
+		dbclt::odbc::statement stmt( session );
+		for( int i = 0; i < 3; ++i )
+		{
+			dbclt::odbc::result res = stmt.execute_params(
+				"insert into tmp values (?,?,?,?,?,?,?)", s1, i1 + i, i2, f, b, tt, dt );
+			REQUIRE( res.affected_count( ) == 1 );
+		}
+
+		for( int32_t i = 1; i <= 3; ++i )
+		{
+			dbclt::odbc::recordset rs = stmt.query_params( "select * from tmp where i = ?", i );
+			size_t processed = 0;
+			for( const dbclt::odbc::record& rec: rs )
+			{
+				REQUIRE( rec.get_string( 0 ) == "t1" );
+				REQUIRE( rec.get_int32( 1 ) == i );
+				REQUIRE( rec.get_int64( 2 ) == 1234567890123456789 );
+				REQUIRE( rec.get_double( 3 ) == Approx( 1.1 ).epsilon( 0.00001 ) );
+				REQUIRE( rec.get_bool( 4 ) );
+				REQUIRE( rec.get_string( 5 ) == "long text" );
+				REQUIRE( rec.get_datetime( 6 ) == dt );
+				processed++;
+			}
+			REQUIRE( processed == 1 );
+		}
+	}
+
+	SECTION( "Async" )
+	{
+		dbclt::odbc::async_scheduler scheduler( 1 );
+
+		std::vector< dbclt::odbc::session > sessions( 4 );
+		std::vector< std::future< dbclt::odbc::recordset > > futures;
+		for( int32_t i = 0; i < 4; ++i )
+		{
+			sessions[ i ].connect( connInfo );
+			futures.push_back( sessions[ i ].backend( ).async_query(
+				"select " + std::to_string( i ) + " from pg_sleep(0.2)", scheduler ) );
+		}
+
+		for( int32_t i = 0; i < 4; ++i )
+		{
+			dbclt::odbc::recordset rs = futures[ i ].get( );
+			REQUIRE( rs.record_count( ) == 1 );
+			const dbclt::odbc::record& rec = *rs.begin( );
+			REQUIRE( rec.get_int32( 0 ) == i );
+		}
+
+		auto failed = sessions[ 0 ].backend( ).async_execute( "select * from nowhere" );
+		REQUIRE_THROWS_AS( failed.get( ), dbclt::data_exception );
+	}
+
+	SECTION( "BlockCursor" )
+	{
+		dbclt::odbc::session session;
+		session.connect( connInfo );
+		session.backend( ).set_row_array_size( 7 );
+
+		int32_t i = 1;
+		for( const dbclt::odbc::record& rec: session.query(
+				 "select i, cast('v' || i as varchar(10)), case when i % 2 = 0 then i end "
+				 "from generate_series(1, 1000) i" ) )
+		{
+			REQUIRE( rec.get_int32( 0 ) == i );
+			REQUIRE( rec.get_string( 1 ) == "v" + std::to_string( i ) );
+			REQUIRE( rec.is_null( 2 ) == ( i % 2 != 0 ) );
+			if( i % 2 == 0 )
+				REQUIRE( rec.get_int32( 2 ) == i );
+			++i;
+		}
+		REQUIRE( i == 1001 );
+	}
+
+	SECTION( "Recordsets" )
+	{
+		dbclt::odbc::session session;
+		session.connect( connInfo );
+		session.execute( "create temp table tmp (i integer null)" );
+
+		dbclt::odbc::result res = session.execute(
+			"select i from generate_series(1, 500) i; "
+			"insert into tmp values (1); "
+			"select i, cast('v' || i as varchar(10)) from generate_series(1, 3) i; "
+			"select i from generate_series(501, 1000) i" );
+
+		std::vector< std::vector< int32_t > > values;
+		for( dbclt::odbc::recordset& rs: res.recordsets( ) )
 		{
-			MyRecord( std::string( "t1" ), 1, 1234567890123456789, 1.1, true, std::string( "tt1" ), dbclt::datetime( date::sys_days( date::year( 2019 ) / 12 / 9 ) ) ),
-			MyRecord( std::string( "t2" ), 2, 2345678901234567891, 2.2, false, std::string( "tt2" ), dbclt::datetime( date::sys_days( date::year( 2019 ) / 12 / 10 ) ) ),
-			MyRecord( std::string( "t3" ), 3, 3456789012345678912, 3.3, true, std::string( "tt3" ), dbclt::datetime( date::sys_days( date::year( 2019 ) / 12 / 11 ) ) )
+			values.emplace_back( );
+			for( const dbclt::odbc::record& rec: rs )
+				values.back( ).push_back( rec.get_int32( 0 ) );
+		}
+
+		REQUIRE( values.size( ) == 3 );
+		REQUIRE( values[ 0 ].size( ) == 500 );
+		REQUIRE( values[ 0 ].back( ) == 500 );
+		REQUIRE( values[ 1 ] == std::vector< int32_t > { 1, 2, 3 } );
+		REQUIRE( values[ 2 ].size( ) == 500 );
+		REQUIRE( values[ 2 ].front( ) == 501 );
+	}
+
+	SECTION( "ColumnCache" )
+	{
+		dbclt::odbc::session session;
+		session.connect( connInfo );
+		session.backend( ).set_row_array_size( 64 );
+		session.execute( "create temp table tmp (i integer null, dt timestamp null)" );
+		session.execute( "insert into tmp select i, case when i % 7 = 3 then null else "
+						 "timestamp '2020-01-01' + i * interval '1 hour' end "
+						 "from generate_series(0, 999) i" );
+
+		const dbclt::datetime first( date::sys_days( date::year( 2020 ) / 1 / 1 ) );
+		for( int pass = 0; pass < 2; ++pass )
+		{
+			dbclt::odbc::recordset rs = session.query( "select * from tmp" );
+			REQUIRE( rs.fields( )[ 1 ].name( ) == "dt" );
+			for( const dbclt::odbc::record& rec: rs )
+			{
+				const int32_t i = rec.get_int32( 0 );
+				REQUIRE( rec.is_null( 1 ) == ( i % 7 == 3 ) );
+				if( i % 7 != 3 )
+					REQUIRE( rec.get_datetime( 1 ) == first + std::chrono::hours( i ) );
+			}
+		}
+
+		// ddl drops the cached descriptions
+		session.execute( "drop table tmp" );
+		session.execute( "create temp table tmp (s varchar(10) null, d float null)" );
+		session.execute( "insert into tmp values ('a', 1.5)" );
+		dbclt::odbc::recordset rs = session.query( "select * from tmp" );
+		REQUIRE( rs.fields( )[ 0 ].name( ) == "s" );
+		const dbclt::odbc::record& rec = *rs.begin( );
+		REQUIRE( rec.get_string( 0 ) == "a" );
+		REQUIRE( rec.get_double( 1 ) == 1.5 );
+
+		// a cached description is checked against the types another connection changed
+		session.execute( "drop table if exists dbclt_column_cache" );
+		session.execute( "create table dbclt_column_cache (i integer null, s varchar(10) null)" );
+		session.execute( "insert into dbclt_column_cache values (1, 'a')" );
+		rs = session.query( "select * from dbclt_column_cache" );
+		REQUIRE( rs.begin( )->get_string( 1 ) == "a" );
+
+		dbclt::odbc::session other;
+		other.connect( connInfo );
+		other.execute( "alter table dbclt_column_cache alter column i type float8, "
+					   "alter column s type varchar(200)" );
+		other.execute( "update dbclt_column_cache set i = 2.5, s = repeat('b', 150)" );
+
+		rs = session.query( "select * from dbclt_column_cache" );
+		const dbclt::odbc::record& changed = *rs.begin( );
+		REQUIRE( changed.get_double( 0 ) == 2.5 );
+		REQUIRE( changed.get_string( 1 ) == std::string( 150, 'b' ) );
+		session.execute( "drop table dbclt_column_cache" );
+	}
+
+	SECTION( "LongData" )
+	{
+		dbclt::odbc::session session;
+		session.connect( connInfo );
+
+		int32_t i = 1;
+		for( const dbclt::odbc::record& rec:
+			 session.query( "select i, repeat(chr(96 + i), i * 500000)::text, "
+							"case when i % 2 = 0 then 'x'::text end "
+							"from generate_series(1, 4) i" ) )
+		{
+			size_t size = 0;
+			size_t chunks = 0;
+			REQUIRE( rec.read_blob( 1, [ & ]( const char* data, size_t length ) {
+				REQUIRE( std::string( data, length ) == std::string( length, ( char )( 96 + i ) ) );
+				size += length;
+				chunks++;
+			} ) );
+			REQUIRE( size == ( size_t )i * 500000 );
+			REQUIRE( chunks > 1 );
+
+			REQUIRE( rec.is_null( 2 ) == ( i % 2 != 0 ) );
+			if( i % 2 == 0 )
+				REQUIRE( rec.get_string( 2 ) == "x" );
+			REQUIRE( rec.get_int32( 0 ) == i );
+			++i;
+		}
+		REQUIRE( i == 5 );
+	}
+
+	SECTION( "RowBinding" )
+	{
+		struct row
+		{
+			int32_t i;
+			std::string s;
+			std::optional< int64_t > n;
+			double d;
 		};
 
+		dbclt::odbc::session session;
+		session.connect( connInfo );
+		session.backend( ).set_row_array_size( 64 );
+
+		std::vector< row > rows;
+		session
+			.query( "select i, cast('v' || i as varchar(10)), case when i % 2 = 0 then i end, "
+					"i / 4.0 from generate_series(1, 1000) i" )
+			.into( rows );
+
+		REQUIRE( rows.size( ) == 1000 );
+		for( int32_t i = 1; i <= 1000; ++i )
+		{
+			const row& r = rows[ i - 1 ];
+			REQUIRE( r.i == i );
+			REQUIRE( r.s == "v" + std::to_string( i ) );
+			REQUIRE( r.n.has_value( ) == ( i % 2 == 0 ) );
+			if( r.n )
+				REQUIRE( *r.n == i );
+			REQUIRE( r.d == Approx( i / 4.0 ) );
+		}
+	}
+
+	SECTION( "BulkInsert" )
+	{
+		dbclt::odbc::session session;
+		session.connect( connInfo );
+		session.execute( "create temp table tmp (t varchar(100) null, i integer null, bi bigint "
+						 "null, f float null, b boolean null, tt text null, dt timestamp null)" );
+
+		const std::vector< MyRecord > toInsert = make_records( 10000 );
 		session.bulk_insert( "tmp", toInsert );
 
 		std::vector< MyRecord > records;
-		session.query( "select * from tmp" ).into( records );
-		REQUIRE( records.size( ) == 3 );
-
+		session.query( "select * from tmp order by i" ).into( records );
+		REQUIRE( records.size( ) == toInsert.size( ) );
 		for( size_t i = 0; i < records.size( ); ++i )
+		{
 			REQUIRE( records[ i ] == toInsert[ i ] );
-#endif
+			REQUIRE( records[ i ].i == toInsert[ i ].i );
+			REQUIRE( records[ i ].tt == toInsert[ i ].tt );
+			REQUIRE( records[ i ].dt == toInsert[ i ].dt );
+		}
+	}
+
+	SECTION( "Export" )
+	{
+		dbclt::odbc::session session;
+		session.connect( connInfo );
+		session.execute( "create temp table tmp (t varchar(100) null, i integer null, bi bigint "
+						 "null, f float null, b boolean null, tt text null, dt timestamp null)" );
+		session.execute( "insert into tmp values ('t1', 1, 1234567890123456789, 1.1, true, 'long "
+						 "\"text\", with comma', '2019-12-09')" );
+		session.execute( "insert into tmp values (null, null, null, null, null, null, null)" );
+
+		{
+			std::ostringstream os;
+			session.query( "select * from tmp" ).write_csv( os );
+			REQUIRE( os.str( ) == "t,i,bi,f,b,tt,dt\n"
+								  "t1,1,1234567890123456789,1.1,true,\"long \"\"text\"\", with "
+								  "comma\",2019-12-09T00:00:00.000000\n"
+								  ",,,,,,\n" );
+		}
+
+		{
+			std::ostringstream os;
+			session.query( "select * from tmp" ).write_jsonl( os );
+			REQUIRE( os.str( ) ==
+					 "{\"t\":\"t1\",\"i\":1,\"bi\":1234567890123456789,\"f\":1.1,\"b\":true,"
+					 "\"tt\":\"long \\\"text\\\", with comma\","
+					 "\"dt\":\"2019-12-09T00:00:00.000000\"}\n"
+					 "{\"t\":null,\"i\":null,\"bi\":null,\"f\":null,\"b\":null,\"tt\":null,"
+					 "\"dt\":null}\n" );
+		}
 	}
 
 	SECTION( "Transaction" )
@@ -369,3 +655,41 @@ TEST_CASE( "odbc" )
 		}
 	}
 }
+
+// opt-in, run with "[!benchmark]": bulk_insert against one execute per row, on the SQLite ODBC
+// driver unless DBXX_TEST_ODBC_BENCH_CONNSTRING names another one
+TEST_CASE( "odbc bulk insert", "[!benchmark]" )
+{
+	dbclt::odbc::session session;
+	session.connect( benchConnInfo );
+	session.execute( "create temp table bench (t varchar(100) null, i integer null, bi bigint "
+					 "null, f float null, b boolean null, tt text null, dt timestamp null)" );
+
+	const std::vector< MyRecord > rows = make_records( 10000 );
+
+	BENCHMARK( "bulk_insert" )
+	{
+		session.execute( "delete from bench" );
+		session.bulk_insert( "bench", rows );
+	};
+
+	BENCHMARK( "execute_params per row" )
+	{
+		session.execute( "delete from bench" );
+		dbclt::odbc::transaction tr( session );
+		for( const MyRecord& rec: rows )
+			session.execute_params( "insert into bench values (?,?,?,?,?,?,?)",
+									*rec.t,
+									*rec.i,
+									*rec.bi,
+									*rec.f,
+									*rec.b,
+									rec.tt.value_or( "" ),
+									*rec.dt );
+		tr.commit( );
+	};
+
+	std::vector< MyRecord > inserted;
+	session.query( "select * from bench order by i" ).into( inserted );
+	REQUIRE( inserted.size( ) == rows.size( ) );
+}
@@ -24,11 +24,15 @@ SOFTWARE.
 
 #include <catch2/catch.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <date/date.h>
 #include <iostream>
+#include <iterator>
+#include <sstream>
 
 #include <dbclt/postgres.h>
+#include <dbclt/snapshot.h>
 
 #include <structs/to_tuple.h>
 
@@ -50,6 +54,59 @@ static const std::string connInfo( env( "DBXX_TEST_POSTGRES_CONNSTRING",
 										"hostaddr=localhost port=5432 sslmode=prefer "
 										"dbname=postgres user=postgres password=secret" ) );
 
+// header of an arrow ipc message, read from its flatbuffer
+struct arrow_message
+{
+	uint8_t type;        // 1 schema, 3 record batch
+	size_t children;     // schema fields or record batch buffers
+	int64_t bodyLength;  // bytes following the metadata
+};
+
+static std::vector< arrow_message > read_arrow_messages( const std::vector< char >& stream )
+{
+	const char* data = stream.data( );
+	auto u16 = [ & ]( size_t pos ) {
+		uint16_t value;
+		memcpy( &value, data + pos, sizeof( value ) );
+		return value;
+	};
+	auto u32 = [ & ]( size_t pos ) {
+		uint32_t value;
+		memcpy( &value, data + pos, sizeof( value ) );
+		return value;
+	};
+	// position of a table field, 0 when absent
+	auto field = [ & ]( size_t table, size_t ndx ) -> size_t {
+		const size_t vtable = table - ( int32_t )u32( table );
+		if( ( ndx + 2 ) * 2 >= u16( vtable ) )
+			return 0;
+		const uint16_t offset = u16( vtable + ( ndx + 2 ) * 2 );
+		return offset ? table + offset : 0;
+	};
+
+	std::vector< arrow_message > messages;
+	size_t pos = 0;
+	while( pos + 8 <= stream.size( ) && u32( pos ) == 0xFFFFFFFF && u32( pos + 4 ) > 0 )
+	{
+		const size_t metadata = pos + 8;
+		const size_t root = metadata + u32( metadata );
+		const size_t header = field( root, 2 ) + u32( field( root, 2 ) );
+
+		arrow_message message { };
+		message.type = ( uint8_t )data[ field( root, 1 ) ];
+		if( field( root, 3 ) )
+			memcpy( &message.bodyLength, data + field( root, 3 ), sizeof( int64_t ) );
+		const size_t children = field( header, message.type == 1 ? 1 : 2 );
+		if( children )
+			message.children = u32( children + u32( children ) );
+
+		messages.push_back( message );
+		pos = metadata + u32( pos + 4 ) + ( size_t )message.bodyLength;
+	}
+	REQUIRE( pos + 8 == stream.size( ) );
+	return messages;
+}
+
 struct MyRecord
 {
 	std::optional< std::string > t;
@@ -389,6 +446,31 @@ void dbclt::convert( const dbclt::record< BE >& from, MyRecord& to )
 	#endif
 #endif
 
+struct geo_point
+{
+	double x;
+	double y;
+};
+
+template<>
+struct dbclt::postgres::codec< geo_point >
+{
+	static geo_point decode( const char* value, int length )
+	{
+		if( length != 16 )
+			return geo_point { };
+		return geo_point { dbclt::util::big_to_native64( *( const double* )value ),
+						   dbclt::util::big_to_native64( *( const double* )( value + 8 ) ) };
+	}
+
+	static std::string encode( const geo_point& value )
+	{
+		const double coords[] = { dbclt::util::big_to_native64( value.x ),
+								  dbclt::util::big_to_native64( value.y ) };
+		return std::string( ( const char* )coords, sizeof( coords ) );
+	}
+};
+
 TEST_CASE( "postgres" )
 {
 	SECTION( "NotInitialized" )
@@ -549,6 +631,73 @@ TEST_CASE( "postgres" )
 		}
 	}
 
+	SECTION( "IntoParallel" )
+	{
+		dbclt::postgres::session session;
+		session.connect( connInfo );
+
+		struct data
+		{
+			int32_t i;
+			std::string t;
+		};
+
+		dbclt::postgres::recordset rs =
+			session.query( "select i, 'v' || i from generate_series(0, 99999) i" );
+
+		// rows keep their result order whatever thread converted them
+		std::vector< data > rows;
+		rs.into_parallel( rows, 4 );
+		REQUIRE( rows.size( ) == 100000 );
+		bool ordered = true;
+		for( size_t i = 0; i < rows.size( ); ++i )
+			ordered &= rows[ i ].i == ( int32_t )i && rows[ i ].t == "v" + std::to_string( i );
+		REQUIRE( ordered );
+
+		// the recordset's own cursor is left untouched
+		size_t count = 0;
+		for( const dbclt::postgres::record& rec: rs )
+			count += rec.get_int32( 0 ) == ( int32_t )count;
+		REQUIRE( count == 100000 );
+
+		std::vector< data > few;
+		session.query( "select 1, 'one'" ).into_parallel( few );
+		REQUIRE( few.size( ) == 1 );
+		REQUIRE( few.front( ).t == "one" );
+	}
+
+	SECTION( "RandomAccess" )
+	{
+		dbclt::postgres::session session;
+		session.connect( connInfo );
+		dbclt::postgres::recordset rs =
+			session.query( "select i * 2 from generate_series(0, 999) i" );
+
+		REQUIRE( std::distance( rs.begin( ), rs.end( ) ) == 1000 );
+
+		// iterators over the same recordset move independently
+		dbclt::postgres::recordset::iterator first = rs.begin( );
+		dbclt::postgres::recordset::iterator tenth = first + 10;
+		++first;
+		REQUIRE( first->get_int32( 0 ) == 2 );
+		REQUIRE( tenth->get_int32( 0 ) == 20 );
+		REQUIRE( first[ 5 ].get_int32( 0 ) == 12 );
+		REQUIRE( tenth - first == 9 );
+
+		// binary search over an ordered result
+		dbclt::postgres::recordset::iterator found = std::lower_bound(
+			rs.begin( ), rs.end( ), 500, []( const dbclt::postgres::record& rec, int32_t value ) {
+				return rec.get_int32( 0 ) < value;
+			} );
+		REQUIRE( found - rs.begin( ) == 250 );
+
+		std::reverse_iterator< dbclt::postgres::recordset::iterator > last( rs.end( ) );
+		REQUIRE( last->get_int32( 0 ) == 1998 );
+		REQUIRE( std::count_if( rs.begin( ), rs.end( ), []( const dbclt::postgres::record& rec ) {
+					 return rec.get_int32( 0 ) % 4 == 0;
+				 } ) == 500 );
+	}
+
 	SECTION( "ParamBinding" )
 	{
 		dbclt::postgres::session session;
@@ -633,7 +782,218 @@ end; $$)" );
 #endif
 	}
 
-#if 0
+	SECTION( "Decimal" )
+	{
+		dbclt::postgres::session session;
+		session.connect( connInfo );
+
+		dbclt::postgres::recordset rs = session.query(
+			"select 1234.5678::numeric, -0.005::numeric(10,3), 'NaN'::numeric, "
+			"12345678901234567890123456.789::numeric, 100000000::numeric, 42::int4" );
+		const dbclt::postgres::record& rec = *rs.begin( );
+		REQUIRE( rec.get_decimal( 0 ).to_string( ) == "1234.5678" );
+		REQUIRE( rec.get_double( 0 ) == Approx( 1234.5678 ) );
+		REQUIRE( rec.get_decimal( 1 ).to_string( ) == "-0.005" );
+		REQUIRE( rec.get_decimal( 2 ).is_nan( ) );
+		REQUIRE( rec.get_decimal( 3 ).to_string( ) == "12345678901234567890123456.789" );
+		REQUIRE( rec.get_decimal( 4 ) == dbclt::decimal( 100000000 ) );
+		REQUIRE( rec.get_decimal( 5 ) == dbclt::decimal( 42 ) );
+
+		// bound in binary and read back without a text round trip
+		const dbclt::decimal price( "-98765.4321" );
+		rs = session.query_params( "select $1::numeric * 2", price );
+		REQUIRE( rs.begin( )->get_decimal( 0 ).to_string( ) == "-197530.8642" );
+
+		// 38 digits with a partial last fraction group
+		const dbclt::decimal wide( "1234567890123456789012345678901234567.8" );
+		const std::string encoded = dbclt::postgres::detail::encode_numeric( wide );
+		const int length = ( int )encoded.size( );
+		REQUIRE( dbclt::postgres::detail::decode_numeric( encoded.data( ), length ) == wide );
+		rs = session.query_params( "select $1::numeric", wide );
+		REQUIRE( rs.begin( )->get_decimal( 0 ) == wide );
+
+		struct data
+		{
+			dbclt::decimal amount;
+			std::optional< dbclt::decimal > fee;
+		};
+
+		std::vector< data > rows;
+		session.query( "select 19.99::numeric(8,2), null::numeric" ).into( rows );
+		REQUIRE( rows.size( ) == 1 );
+		REQUIRE( rows.front( ).amount == dbclt::decimal( 1999, 2 ) );
+		REQUIRE( !rows.front( ).fee );
+
+		REQUIRE( dbclt::decimal( "1.50" ) == dbclt::decimal( "1.5" ) );
+		REQUIRE( dbclt::decimal( "12.345" ).rescale( 2 ).to_string( ) == "12.34" );
+		REQUIRE_THROWS_AS( dbclt::decimal( "1e5" ), dbclt::data_exception );
+		REQUIRE_THROWS_AS( dbclt::decimal( 5, 40 ), dbclt::data_exception );
+	}
+
+	SECTION( "ExtendedTypes" )
+	{
+		dbclt::postgres::session session;
+		session.connect( connInfo );
+
+		dbclt::postgres::recordset rs =
+			session.query( "select 'a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11'::uuid, "
+						   "'1 year 2 mons 3 days 04:05:06.5'::interval, '192.168.0.1/24'::inet, "
+						   "'2001:db8::/32'::cidr, '13:14:15'::time, '01:00:00+02'::timetz, "
+						   "'{\"a\": 1}'::jsonb, '\\x000102'::bytea" );
+		const dbclt::postgres::record& rec = *rs.begin( );
+		REQUIRE( rs.fields( )[ 0 ].db_type( ) == dbclt::field::type::db_uuid );
+		REQUIRE( rec.get_uuid( 0 ) == dbclt::uuid( "a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11" ) );
+		REQUIRE( rec.get_interval( 1 ).months == 14 );
+		REQUIRE( rec.get_interval( 1 ).days == 3 );
+		REQUIRE( rec.get_interval( 1 ).microseconds == 14706500000 );
+		REQUIRE( rec.get_string( 1 ) == "P1Y2M3DT4H5M6.5S" );
+		REQUIRE( rec.get_inet( 2 ).bits == 24 );
+		REQUIRE( rec.get_string( 2 ) == "192.168.0.1/24" );
+		REQUIRE( rec.get_string( 3 ) == "2001:db8::/32" );
+		REQUIRE( rec.get_time( 4 ) == std::chrono::hours( 13 ) + std::chrono::minutes( 14 ) +
+										  std::chrono::seconds( 15 ) );
+		REQUIRE( rec.get_string( 5 ) == "23:00:00" );
+		REQUIRE( rec.get_string_view( 6 ) == "{\"a\": 1}" );
+		REQUIRE( rec.get_string_view( 7 ) == std::string_view( "\0\1\2", 3 ) );
+
+		struct data
+		{
+			dbclt::uuid id;
+			dbclt::interval period;
+			dbclt::inet address;
+			dbclt::time_of_day at;
+			std::string document;
+			std::vector< uint8_t > payload;
+		};
+
+		// every type is bound in binary and decoded back by the typed query
+		data in;
+		in.id = dbclt::uuid( "{6ba7b810-9dad-11d1-80b4-00c04fd430c8}" );
+		in.period.days = -2;
+		in.period.microseconds = 1500000;
+		in.address.address = { 10, 0, 0, 1 };
+		in.at = std::chrono::hours( 23 );
+		in.payload = { 0, 255 };
+
+		std::vector< data > rows;
+		for( const data& row: session.query_as< data >(
+				 "select $1, $2, $3, $4, '[1, 2]'::jsonb, $5", in.id, in.period, in.address,
+				 in.at, in.payload ) )
+			rows.push_back( row );
+		REQUIRE( rows.size( ) == 1 );
+		REQUIRE( rows.front( ).id == in.id );
+		REQUIRE( rows.front( ).period == in.period );
+		REQUIRE( rows.front( ).address == in.address );
+		REQUIRE( rows.front( ).address.to_string( ) == "10.0.0.1" );
+		REQUIRE( rows.front( ).at == in.at );
+		REQUIRE( rows.front( ).document == "[1, 2]" );
+		REQUIRE( rows.front( ).payload == in.payload );
+	}
+
+	SECTION( "TypeRegistry" )
+	{
+		auto types = std::make_shared< dbclt::postgres::type_registry >( );
+		types->add< geo_point >( "point" );
+
+		dbclt::postgres::session session;
+		session.backend( ).set_types( types );
+		session.connect( connInfo );
+		REQUIRE( types->oid< geo_point >( ) == 600 );
+
+		dbclt::postgres::recordset rs = session.query( "select '(1.5,-2)'::point, 1" );
+		const dbclt::postgres::record& rec = *rs.begin( );
+		REQUIRE( rec.get_custom< geo_point >( 0 ).x == 1.5 );
+		REQUIRE( rec.get_custom< geo_point >( 0 ).y == -2 );
+		REQUIRE_THROWS_AS( rec.get_custom< geo_point >( 1 ), dbclt::data_exception );
+
+		struct located
+		{
+			geo_point at;
+			std::optional< geo_point > previous;
+		};
+
+		const located converted = dbclt::convert< located >( rec );
+		REQUIRE( converted.at.x == 1.5 );
+		REQUIRE( converted.previous->y == -2 );
+
+		// bound with the resolved oid and decoded back by the typed query
+		std::vector< located > rows;
+		for( const located& row: session.query_as< located >(
+				 "select $1, null::point", geo_point { 3, 4 } ) )
+			rows.push_back( row );
+		REQUIRE( rows.size( ) == 1 );
+		REQUIRE( rows.front( ).at.x == 3 );
+		REQUIRE( rows.front( ).at.y == 4 );
+		REQUIRE( !rows.front( ).previous );
+
+		// a second session of the same registry reuses the resolved oids
+		dbclt::postgres::session other;
+		other.backend( ).set_types( types );
+		other.connect( connInfo );
+		REQUIRE( other.query_params( "select $1::point", geo_point { 5, 6 } )
+					 .begin( )
+					 ->get_custom< geo_point >( 0 )
+					 .x == 5 );
+	}
+
+	SECTION( "Composite" )
+	{
+		dbclt::postgres::session session;
+		session.connect( connInfo );
+		session.execute( "drop type if exists dbclt_tag cascade" );
+		session.execute( "create type dbclt_tag as (label text, weight int2)" );
+
+		struct tag
+		{
+			std::string label;
+			int16_t weight;
+		};
+
+		struct item
+		{
+			int32_t id;
+			std::optional< double > price;
+			std::vector< tag > tags;
+		};
+
+		struct order
+		{
+			int64_t id;
+			item first;
+			std::vector< item > items;
+			std::vector< int32_t > quantities;
+		};
+
+		// one row holding the whole object graph
+		const std::string stmt =
+			"select 1::int8, row(10, null::float8, array[('a', 1)::dbclt_tag]), "
+			"array[row(11, 2.5::float8, array[('b', 2)::dbclt_tag, ('c', 3)::dbclt_tag]), "
+			"row(12, 3.5::float8, array[]::dbclt_tag[])], array[4, 5, 6]";
+
+		std::vector< order > orders;
+		for( const order& row: session.query_as< order >( stmt ) )
+			orders.push_back( row );
+		REQUIRE( orders.size( ) == 1 );
+		REQUIRE( orders.front( ).first.id == 10 );
+		REQUIRE( !orders.front( ).first.price );
+		REQUIRE( orders.front( ).first.tags.front( ).label == "a" );
+		REQUIRE( orders.front( ).items.size( ) == 2 );
+		REQUIRE( orders.front( ).items[ 0 ].tags[ 1 ].weight == 3 );
+		REQUIRE( *orders.front( ).items[ 1 ].price == 3.5 );
+		REQUIRE( orders.front( ).items[ 1 ].tags.empty( ) );
+		REQUIRE( orders.front( ).quantities == std::vector< int32_t > { 4, 5, 6 } );
+
+		dbclt::postgres::recordset rs = session.query( stmt );
+		const dbclt::postgres::record& rec = *rs.begin( );
+		const order converted = dbclt::convert< order >( rec );
+		REQUIRE( converted.items[ 0 ].tags[ 0 ].label == "b" );
+		REQUIRE( rec.get_custom< std::vector< item > >( 2 ).size( ) == 2 );
+		REQUIRE_THROWS_AS( rec.get_custom< tag >( 1 ), dbclt::data_exception );
+		REQUIRE_THROWS_AS( rec.get_custom< item >( 0 ), dbclt::data_exception );
+
+		session.execute( "drop type dbclt_tag cascade" );
+	}
+
 	SECTION( "BulkInsert" )
 	{
 		dbclt::postgres::session session;
@@ -674,7 +1034,317 @@ end; $$)" );
 		for( size_t i = 0; i < records.size( ); ++i )
 			REQUIRE( records[ i ] == toInsert[ i ] );
 	}
+
+	SECTION( "ParallelBulkInsert" )
+	{
+		dbclt::postgres::session session;
+		session.connect( connInfo );
+		session.execute( "drop table if exists dbclt_load" );
+		session.execute( "create table dbclt_load (t varchar(100) null, i integer null, bi bigint "
+						 "null, f float null, b boolean null, tt text null, dt timestamp null)" );
+
+		std::vector< MyRecord > toInsert;
+		for( int32_t i = 0; i < 100000; ++i )
+			toInsert.push_back( MyRecord {
+				"t" + std::to_string( i ),
+				i,
+				1234567890123456789 + i,
+				i / 4.0,
+				i % 2 == 0,
+				i % 3 == 0 ? std::optional< std::string >( ) : "tt" + std::to_string( i ),
+				dbclt::datetime( date::sys_days( date::year( 2019 ) / 12 / 9 ) +
+								 std::chrono::seconds( i ) ) } );
+
+		std::vector< dbclt::postgres::bulk_insert_stats > stats =
+			dbclt::postgres::parallel_bulk_insert( connInfo, "dbclt_load", toInsert, 4, true );
+		REQUIRE( stats.size( ) == 4 );
+		size_t rows = 0;
+		for( const dbclt::postgres::bulk_insert_stats& s: stats )
+		{
+			rows += s.rows;
+			REQUIRE( s.bytes > 0 );
+		}
+		REQUIRE( rows == toInsert.size( ) );
+
+		std::vector< MyRecord > records;
+		session.query( "select * from dbclt_load order by i" ).into( records );
+		REQUIRE( records.size( ) == toInsert.size( ) );
+		for( size_t i = 0; i < records.size( ); ++i )
+			REQUIRE( records[ i ] == toInsert[ i ] );
+
+		// a row the table rejects leaves nothing behind in all or nothing mode
+		session.execute( "alter table dbclt_load add constraint positive check (i >= 0)" );
+		toInsert[ 99999 ].i = -1;
+		REQUIRE_THROWS_AS(
+			dbclt::postgres::parallel_bulk_insert( connInfo, "dbclt_load", toInsert, 4, true ),
+			dbclt::data_exception );
+		REQUIRE( session.query( "select count(*) from dbclt_load" ).begin( )->get_int64( 0 ) ==
+				 100000 );
+
+		session.execute( "drop table dbclt_load" );
+	}
+
+	SECTION( "Export" )
+	{
+		dbclt::postgres::session session;
+		session.connect( connInfo );
+		session.execute( "create temp table tmp (t varchar(100) null, i integer null, bi bigint "
+						 "null, f float null, b boolean null, tt text null, dt timestamp null)" );
+		session.execute( "insert into tmp values ('t1', 1, 1234567890123456789, 1.1, true, 'long "
+						 "\"text\", with comma', '2019-12-09')" );
+		session.execute( "insert into tmp values (null, null, null, null, null, null, null)" );
+
+		{
+			std::ostringstream os;
+			session.query( "select * from tmp" ).write_csv( os );
+			REQUIRE( os.str( ) == "t,i,bi,f,b,tt,dt\n"
+								  "t1,1,1234567890123456789,1.1,true,\"long \"\"text\"\", with "
+								  "comma\",2019-12-09T00:00:00.000000\n"
+								  ",,,,,,\n" );
+		}
+
+		{
+			std::ostringstream os;
+			session.query( "select * from tmp" ).write_jsonl( os );
+			REQUIRE( os.str( ) ==
+					 "{\"t\":\"t1\",\"i\":1,\"bi\":1234567890123456789,\"f\":1.1,\"b\":true,"
+					 "\"tt\":\"long \\\"text\\\", with comma\","
+					 "\"dt\":\"2019-12-09T00:00:00.000000\"}\n"
+					 "{\"t\":null,\"i\":null,\"bi\":null,\"f\":null,\"b\":null,\"tt\":null,"
+					 "\"dt\":null}\n" );
+		}
+
+		{
+			std::ostringstream os;
+			session.query( "select t, i from tmp" ).write_csv( os, ',', false );
+			REQUIRE( os.str( ) == "t1,1\n,\n" );
+		}
+
+		{
+			// json has no representation for nan and infinity
+			std::ostringstream os;
+			session.query( "select 'NaN'::float8 as n, '-Infinity'::float8 as i, 1.5::float8 as f" )
+				.write_jsonl( os );
+			REQUIRE( os.str( ) == "{\"n\":null,\"i\":null,\"f\":1.5}\n" );
+		}
+	}
+
+	SECTION( "Arrow" )
+	{
+		dbclt::postgres::session session;
+		session.connect( connInfo );
+
+		std::vector< char > buffer;
+		session.query( "select i, 'v' || i as t from generate_series(1, 10) i" )
+			.write_arrow( buffer, 4 );
+
+		REQUIRE( buffer.size( ) % 8 == 0 );
+		REQUIRE( buffer.size( ) > 16 );
+
+		// schema, then three batches of validity and values buffers for the integers and
+		// validity, offsets and values for the strings
+		const std::vector< arrow_message > messages = read_arrow_messages( buffer );
+		REQUIRE( messages.size( ) == 4 );
+		REQUIRE( messages[ 0 ].type == 1 );
+		REQUIRE( messages[ 0 ].children == 2 );
+		for( size_t i = 1; i < messages.size( ); ++i )
+		{
+			REQUIRE( messages[ i ].type == 3 );
+			REQUIRE( messages[ i ].children == 5 );
+			REQUIRE( messages[ i ].bodyLength % 8 == 0 );
+		}
+
+		uint32_t marker[ 2 ];
+		memcpy( marker, buffer.data( ), sizeof( marker ) );
+		REQUIRE( marker[ 0 ] == 0xFFFFFFFF );
+		REQUIRE( marker[ 1 ] % 8 == 0 );
+
+		memcpy( marker, buffer.data( ) + buffer.size( ) - sizeof( marker ), sizeof( marker ) );
+		REQUIRE( marker[ 0 ] == 0xFFFFFFFF );
+		REQUIRE( marker[ 1 ] == 0 );
+
+		// the formatted types are utf8 columns with an offsets buffer
+		std::vector< char > formatted;
+		session
+			.query( "select '13:14:15'::time, '1 day'::interval, "
+					"'a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11'::uuid, '10.0.0.1'::inet" )
+			.write_arrow( formatted );
+
+		const std::vector< arrow_message > formattedMessages = read_arrow_messages( formatted );
+		REQUIRE( formattedMessages.size( ) == 2 );
+		REQUIRE( formattedMessages[ 0 ].children == 4 );
+		REQUIRE( formattedMessages[ 1 ].children == 12 );
+	}
+
+	SECTION( "Snapshot" )
+	{
+		dbclt::postgres::session session;
+		session.connect( connInfo );
+
+		const std::string path = "dbclt_test.snapshot";
+		session
+			.query( "select i, 'v' || i as t, case when i % 2 = 0 then i * 1.5::float8 end as d "
+					"from generate_series(1, 10) i" )
+			.save_snapshot( path );
+
+		dbclt::snapshot::recordset rs = dbclt::snapshot::open( path );
+		REQUIRE( rs.record_count( ) == 10 );
+		REQUIRE( rs.fields( )[ 1 ].name( ) == "t" );
+
+		// each pass starts again from the first row
+		for( int pass = 0; pass < 2; ++pass )
+		{
+			int32_t i = 1;
+			for( const dbclt::snapshot::record& record: rs )
+			{
+				REQUIRE( record.get_int32( 0 ) == i );
+				REQUIRE( record.get_string( 1 ) == "v" + std::to_string( i ) );
+				REQUIRE( record.is_null( 2 ) == ( i % 2 != 0 ) );
+				if( i % 2 == 0 )
+					REQUIRE( record.get_double( 2 ) == i * 1.5 );
+				++i;
+			}
+			REQUIRE( i == 11 );
+		}
+
+		struct data
+		{
+			int32_t i;
+			std::string t;
+		};
+		std::vector< data > records;
+		rs.into( records );
+		rs.into( records );
+		REQUIRE( records.size( ) == 20 );
+		REQUIRE( records[ 9 ].i == 10 );
+		REQUIRE( records[ 19 ].t == "v10" );
+
+		// a text offset pointing past the values is refused when the file is opened
+		std::string bytes;
+		{
+			std::ifstream in( path, std::ios::binary );
+			bytes.assign( std::istreambuf_iterator< char >( in ),
+						  std::istreambuf_iterator< char >( ) );
+		}
+		dbclt::detail::snapshot_column column;
+		memcpy( &column,
+				bytes.data( ) + sizeof( dbclt::detail::snapshot_header ) + sizeof( column ),
+				sizeof( column ) );
+		const uint64_t past = column.valuesLength + 1;
+		memcpy( &bytes[ column.offsetsOffset + 10 * sizeof( uint64_t ) ], &past, sizeof( past ) );
+		std::ofstream( path, std::ios::binary ).write( bytes.data( ), bytes.size( ) );
+		REQUIRE_THROWS_AS( dbclt::snapshot::open( path ), dbclt::data_exception );
+
+		std::remove( path.c_str( ) );
+	}
+
+	SECTION( "Cache" )
+	{
+		dbclt::postgres::session session;
+		session.connect( connInfo );
+		session.execute( "create temp table tmp (i integer null, t text null)" );
+		session.execute( "insert into tmp values (1, 'one'), (2, 'two')" );
+
+		const std::string stmt = "select t from tmp where i = $1";
+		auto cache = std::make_shared< dbclt::postgres::result_cache >( );
+		cache->cache( stmt, std::chrono::minutes( 1 ), { "tmp" } );
+		session.backend( ).set_cache( cache );
+
+		auto lookup = [ & ]( int32_t i ) {
+			return session.query_params( stmt, i ).begin( )->get_string( 0 );
+		};
+
+		REQUIRE( lookup( 1 ) == "one" );
+		REQUIRE( lookup( 2 ) == "two" );
+		REQUIRE( cache->count( ) == 2 );
+
+		session.execute( "update tmp set t = 'uno' where i = 1" );
+		REQUIRE( lookup( 1 ) == "one" );
+
+#ifndef WIN32
+		dbclt::postgres::listener listener = session.backend( ).listen( "tmp" );
+		session.execute( "notify tmp" );
+		REQUIRE( listener( ) );
+		REQUIRE( listener.channel( ) == "tmp" );
+		cache->invalidate( listener );
+#else
+		cache->invalidate( "tmp" );
 #endif
+		REQUIRE( cache->count( ) == 0 );
+
+		REQUIRE( lookup( 1 ) == "uno" );
+		REQUIRE( session.query( "select count(*) from tmp" ).begin( )->get_int64( 0 ) == 2 );
+		REQUIRE( cache->count( ) == 1 );
+	}
+
+	SECTION( "Typed query" )
+	{
+		dbclt::postgres::session session;
+		session.connect( connInfo );
+
+		struct data
+		{
+			int32_t i;
+			std::string t;
+			std::optional< double > d;
+		};
+
+		int32_t i = 1;
+		for( data row : session.query_as< data >(
+				 "select i, 'v' || i, case when i % 2 = 0 then i * 1.5::float8 end "
+				 "from generate_series($1::int4, 10) i",
+				 1 ) )
+		{
+			REQUIRE( row.i == i );
+			REQUIRE( row.t == "v" + std::to_string( i ) );
+			REQUIRE( row.d.has_value( ) == ( i % 2 == 0 ) );
+			++i;
+		}
+		REQUIRE( i == 11 );
+
+		REQUIRE_THROWS_AS( session.query_as< data >( "select 'a', 'b', 1.5::float8" ),
+						   dbclt::data_exception );
+	}
+
+	SECTION( "ParallelScan" )
+	{
+		dbclt::postgres::session session;
+		session.connect( connInfo );
+		session.execute( "drop table if exists dbclt_scan" );
+		session.execute( "create table dbclt_scan as select i, 'v' || i as t from "
+						 "generate_series(1, 100000) i union all select null, 'none'" );
+
+		struct data
+		{
+			std::optional< int32_t > i;
+			std::string t;
+		};
+
+		// key ranges, merged back in key order
+		std::vector< data > rows =
+			dbclt::postgres::parallel_scan< data >( connInfo, "dbclt_scan", "i", 4 );
+		REQUIRE( rows.size( ) == 100001 );
+		REQUIRE( *rows.front( ).i == 1 );
+		REQUIRE( !rows.back( ).i );
+
+		// ctid block ranges, each one handed to the consumer on its connection's thread
+		std::atomic< size_t > count { 0 };
+		dbclt::postgres::parallel_scan(
+			connInfo, "dbclt_scan", "", 4, [ & ]( size_t, dbclt::postgres::recordset& rs ) {
+				for( const dbclt::postgres::record& rec: rs )
+					count += !rec.is_null( 0 );
+			} );
+		REQUIRE( count == 100000 );
+
+		rows = dbclt::postgres::parallel_scan< data >(
+			connInfo, "select i, t from dbclt_scan where i % 2 = 0", "i", 3 );
+		REQUIRE( rows.size( ) == 50000 );
+		REQUIRE_THROWS_AS(
+			dbclt::postgres::parallel_scan< data >( connInfo, "select * from dbclt_scan", "", 2 ),
+			dbclt::data_exception );
+
+		session.execute( "drop table dbclt_scan" );
+	}
 
 	SECTION( "Transaction" )
 	{
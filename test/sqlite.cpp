@@ -0,0 +1,270 @@
+/*
+MIT License
+
+Copyright (c) 2021 Patrick Lavoie
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <date/date.h>
+#include <optional>
+
+#include <dbclt/sqlite.h>
+
+static std::string env( const char* var, const char* defValue )
+{
+	const char* value = getenv( var );
+	if( value == nullptr )
+		return defValue;
+	return value;
+}
+
+static const std::string database( env( "DBXX_TEST_SQLITE_DATABASE", "dbclt_test.sqlite" ) );
+
+struct MyRecord
+{
+	std::string t;
+	int32_t i;
+	int64_t bi;
+	double f;
+	bool b;
+	std::optional< std::string > tt;
+	dbclt::datetime dt;
+};
+
+TEST_CASE( "sqlite" )
+{
+	SECTION( "Connect" )
+	{
+		dbclt::sqlite::session session;
+		REQUIRE( !session.connected( ) );
+		REQUIRE_THROWS_AS( session.query( "select 1" ), dbclt::data_exception );
+		REQUIRE_THROWS_AS( session.connect( "file:/nonexistent/dir/db?mode=ro" ),
+						   dbclt::data_exception );
+
+		session.connect( ":memory:" );
+		REQUIRE( session.connected( ) );
+		session.disconnect( );
+		REQUIRE( !session.connected( ) );
+	}
+
+	SECTION( "Simple" )
+	{
+		dbclt::sqlite::session session;
+		session.connect( ":memory:" );
+		session.execute( "create table tmp (t varchar(100), i integer, f real, b boolean, "
+						 "d date, dt datetime, bl blob);"
+						 "insert into tmp values ('t1', 1, 1.5, 1, '2019-12-09', "
+						 "'2019-12-09 10:11:12.5', x'00ff')" );
+
+		dbclt::sqlite::recordset rs = session.query( "select * from tmp" );
+		const dbclt::fields_type& fields = rs.fields( );
+		REQUIRE( fields.size( ) == 7 );
+		REQUIRE( fields[ 0 ].db_type( ) == dbclt::field::type::db_string );
+		REQUIRE( fields[ 1 ].db_type( ) == dbclt::field::type::db_int64 );
+		REQUIRE( fields[ 2 ].db_type( ) == dbclt::field::type::db_double );
+		REQUIRE( fields[ 3 ].db_type( ) == dbclt::field::type::db_bool );
+		REQUIRE( fields[ 4 ].db_type( ) == dbclt::field::type::db_date );
+		REQUIRE( fields[ 5 ].db_type( ) == dbclt::field::type::db_datetime );
+		REQUIRE( fields[ 6 ].db_type( ) == dbclt::field::type::db_binary );
+
+		const dbclt::datetime day( date::sys_days( date::year( 2019 ) / 12 / 9 ) );
+		const dbclt::sqlite::record& rec = *rs.begin( );
+		REQUIRE( rec.get_string_view( 0 ) == "t1" );
+		REQUIRE( rec.get_int32( 1 ) == 1 );
+		REQUIRE( rec.get_double( 2 ) == 1.5 );
+		REQUIRE( rec.get_bool( 3 ) );
+		REQUIRE( rec.get_date( 4 ) == day );
+		REQUIRE( rec.get_datetime( 5 ) ==
+				 day + std::chrono::hours( 10 ) + std::chrono::minutes( 11 ) +
+					 std::chrono::milliseconds( 12500 ) );
+		REQUIRE( rec.get_string_view( 6 ) == std::string_view( "\0\xff", 2 ) );
+
+		// the date functions' numeric forms
+		rs = session.query( "select julianday('2019-12-09'), unixepoch('2019-12-09')" );
+		REQUIRE( rs.begin( )->get_datetime( 0 ) == day );
+		REQUIRE( rs.begin( )->get_datetime( 1 ) == day );
+	}
+
+	SECTION( "ParamBinding" )
+	{
+		dbclt::sqlite::session session;
+		session.connect( ":memory:" );
+		session.execute( "create table tmp (t text, i integer, dt datetime)" );
+
+		const dbclt::datetime dt( date::sys_days( date::year( 2020 ) / 2 / 29 ) +
+								  std::chrono::microseconds( 123456 ) );
+		for( int32_t i = 0; i < 100; ++i )
+			REQUIRE( session
+						 .execute_params( "insert into tmp values (?, ?, ?)",
+										  "t" + std::to_string( i ),
+										  i,
+										  dt + std::chrono::hours( i ) )
+						 .affected_count( ) == 1 );
+
+		// the prepared statement is reused once the previous recordset is gone
+		for( int32_t i = 0; i < 100; ++i )
+		{
+			dbclt::sqlite::recordset rs =
+				session.query_params( "select t, dt from tmp where i = ?", i );
+			REQUIRE( rs.begin( )->get_string( 0 ) == "t" + std::to_string( i ) );
+			REQUIRE( rs.begin( )->get_datetime( 1 ) == dt + std::chrono::hours( i ) );
+		}
+
+		int32_t count = 0;
+		const dbclt::datetime from = dt + std::chrono::hours( 90 );
+		for( const dbclt::sqlite::record& rec:
+			 session.query_params( "select i from tmp where dt >= ?", from ) )
+			REQUIRE( rec.get_int32( 0 ) == 90 + count++ );
+		REQUIRE( count == 10 );
+	}
+
+	SECTION( "BulkInsert" )
+	{
+		dbclt::sqlite::session session;
+		session.connect( ":memory:" );
+		session.execute( "create table tmp (t text, i integer, bi bigint, f real, b boolean, "
+						 "tt text, dt datetime)" );
+
+		std::vector< MyRecord > toInsert;
+		for( int32_t i = 0; i < 10000; ++i )
+			toInsert.push_back( MyRecord {
+				"t" + std::to_string( i ),
+				i,
+				1234567890123456789 + i,
+				i / 4.0,
+				i % 2 == 0,
+				i % 3 == 0 ? std::optional< std::string >( ) : "tt" + std::to_string( i ),
+				dbclt::datetime( date::sys_days( date::year( 2019 ) / 12 / 9 ) +
+								 std::chrono::seconds( i ) ) } );
+		session.bulk_insert( "tmp", toInsert );
+
+		std::vector< MyRecord > records;
+		session.query( "select * from tmp order by i" ).into( records );
+		REQUIRE( records.size( ) == toInsert.size( ) );
+		for( size_t i = 0; i < records.size( ); ++i )
+		{
+			REQUIRE( records[ i ].t == toInsert[ i ].t );
+			REQUIRE( records[ i ].bi == toInsert[ i ].bi );
+			REQUIRE( records[ i ].tt == toInsert[ i ].tt );
+			REQUIRE( records[ i ].dt == toInsert[ i ].dt );
+		}
+
+		// a failing row leaves nothing behind
+		session.execute( "create unique index tmp_i on tmp (i)" );
+		toInsert.erase( toInsert.begin( ), toInsert.end( ) - 10 );
+		toInsert[ 0 ].i = -1;
+		REQUIRE_THROWS_AS( session.bulk_insert( "tmp", toInsert ), dbclt::data_exception );
+		REQUIRE( session.query( "select count(*) from tmp" ).begin( )->get_int64( 0 ) == 10000 );
+	}
+
+	SECTION( "Transaction" )
+	{
+		dbclt::sqlite::session session;
+		session.connect( ":memory:" );
+		session.execute( "create table tmp (i integer)" );
+
+		{
+			dbclt::sqlite::transaction txn( session );
+			session.execute( "insert into tmp values (1)" );
+			{
+				dbclt::sqlite::transaction nested( session );
+				session.execute( "insert into tmp values (2)" );
+			}
+			txn.commit( );
+		}
+
+		dbclt::sqlite::recordset rs = session.query( "select i from tmp" );
+		REQUIRE( rs.begin( )->get_int32( 0 ) == 1 );
+		REQUIRE( ++rs.begin( ) == rs.end( ) );
+	}
+
+	SECTION( "WalAndMmap" )
+	{
+		std::remove( database.c_str( ) );
+
+		dbclt::sqlite::session writer;
+		writer.backend( ).enable_wal( );
+		writer.backend( ).set_mmap_size( 64 * 1024 * 1024 );
+		writer.connect( database );
+		REQUIRE( writer.query( "pragma journal_mode" ).begin( )->get_string( 0 ) == "wal" );
+		REQUIRE( writer.query( "pragma mmap_size" ).begin( )->get_int64( 0 ) ==
+				 64 * 1024 * 1024 );
+		writer.execute( "drop table if exists tmp; create table tmp (i integer)" );
+
+		// a reader keeps its snapshot while the writer commits
+		dbclt::sqlite::session reader;
+		reader.connect( database );
+		writer.execute( "insert into tmp values (1)" );
+		dbclt::sqlite::recordset rs = reader.query( "select i from tmp" );
+		writer.execute( "insert into tmp values (2)" );
+
+		int32_t count = 0;
+		for( const dbclt::sqlite::record& rec: rs )
+			REQUIRE( rec.get_int32( 0 ) == ++count );
+		REQUIRE( count == 1 );
+	}
+
+	SECTION( "Executor" )
+	{
+		std::remove( database.c_str( ) );
+		{
+			dbclt::sqlite::session session;
+			session.backend( ).enable_wal( );
+			session.connect( database );
+			session.execute( "create table tmp (t text, i integer)" );
+			session.execute( "insert into tmp with recursive n(i) as (select 0 union all "
+							 "select i + 1 from n where i < 999) select 't' || i, i from n" );
+		}
+
+		struct row
+		{
+			std::string t;
+			int32_t i;
+		};
+
+		dbclt::executor< dbclt::sqlite::session_impl > executor( database, 4 );
+		REQUIRE( executor.size( ) == 4 );
+
+		std::vector< std::future< std::vector< row > > > futures;
+		for( int32_t i = 0; i < 1000; ++i )
+			futures.push_back(
+				executor.query< row >( "select t, i from tmp where i between ? and ?", i, i + 1 ) );
+		for( int32_t i = 0; i < 1000; ++i )
+		{
+			std::vector< row > rows = futures[ i ].get( );
+			REQUIRE( rows.size( ) == ( i < 999 ? 2 : 1 ) );
+			REQUIRE( rows[ 0 ].t == "t" + std::to_string( i ) );
+		}
+
+		// each task sees the session of the worker it runs on
+		auto count = executor.submit( []( dbclt::sqlite::session& session ) {
+			return session.query( "select count(*) from tmp" ).begin( )->get_int64( 0 );
+		} );
+		REQUIRE( count.get( ) == 1000 );
+
+		REQUIRE( executor.execute( "update tmp set t = ? where i < ?", "x", 10 ).get( ) == 10 );
+		REQUIRE_THROWS_AS( executor.execute( "select * from nope" ).get( ),
+						   dbclt::data_exception );
+	}
+}